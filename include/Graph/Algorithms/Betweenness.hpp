@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+#include <Graph/TaskPool.hpp>
+
+//========================================
+
+struct BetweennessSettings
+{
+	// Number of randomly chosen sources to estimate from, zero for the exact result
+	size_t samples = 0;
+
+	uint64_t seed = 0;
+
+	// Progress reporting and cancellation, optional
+	TaskContext* context = nullptr;
+};
+
+struct Betweenness
+{
+	// Number of shortest paths between other node pairs that pass through every node and edge
+	std::vector<double> nodes {};
+	std::vector<double> edges {};
+
+	// Number of sources the searches were run from
+	size_t sources = 0;
+};
+
+// Node and edge betweenness centrality by Brandes' algorithm over shortest
+// paths counted in hops, which follow the directed edges forwards. The
+// breadth-first searches from different sources run in parallel, each thread
+// with its own path counts, dependency buffers and accumulators, which are
+// summed up at the end. With sampling, only the given number of sources is
+// searched and the result is scaled by n / samples
+Betweenness BetweennessCentrality(const CompactGraph& graph, const BetweennessSettings& settings = {});
+
+//========================================
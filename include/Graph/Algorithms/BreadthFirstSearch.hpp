@@ -0,0 +1,52 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+
+//========================================
+
+struct BreadthFirstSearchSettings
+{
+	// Beamer's heuristics: switch to bottom-up steps when the frontier has more
+	// than 1/alpha of the unexplored arcs, and back to top-down steps when the
+	// frontier has less than 1/beta of the nodes
+	double alpha = 15;
+	double beta  = 18;
+
+	// Stop after the level at which this node is reached
+	CompactGraph::index_t target = std::numeric_limits<CompactGraph::index_t>::max();
+};
+
+struct BreadthFirstSearchResult
+{
+	static constexpr auto unreachable = std::numeric_limits<CompactGraph::index_t>::max();
+
+	// Number of hops from the source, unreachable for the nodes not reached
+	std::vector<CompactGraph::index_t> distances {};
+
+	// Arc every node was reached by, the source points to itself
+	std::vector<CompactGraph::Arc> parents {};
+
+	// Number of nodes reached at every distance
+	std::vector<size_t> level_sizes {};
+
+	// Number of levels processed bottom-up
+	size_t bottom_up_levels = 0;
+
+	// Arcs looked at by both kinds of steps
+	size_t examined_arcs = 0;
+
+	bool reached(CompactGraph::index_t node) const;
+	size_t getReachedCount() const;
+};
+
+// Direction-optimising breadth-first search (Beamer, Asanović & Patterson).
+// Small frontiers are expanded top-down from a node queue, large ones
+// bottom-up, with every unvisited node looking for a parent in the frontier
+// bitmap, which skips most of the arcs on low diameter graphs. Both kinds
+// of steps run in parallel. Directed edges are only followed forwards
+BreadthFirstSearchResult BreadthFirstSearch(const CompactGraph& graph, CompactGraph::index_t src, const BreadthFirstSearchSettings& settings = {});
+
+//========================================
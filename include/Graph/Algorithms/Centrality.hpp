@@ -0,0 +1,62 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+#include <Graph/TaskPool.hpp>
+
+//========================================
+
+// Damping factors PageRank converges with
+constexpr double pagerank_min_damping = 0;
+constexpr double pagerank_max_damping = .99;
+
+struct PowerIterationSettings
+{
+	// Iteration stops when the L1 norm of the change drops below the tolerance
+	double tolerance      = 1e-9;
+	int    max_iterations = 200;
+
+	// PageRank: probability of following an edge instead of jumping to a random node
+	double damping = .85;
+
+	// Katz: attenuation of longer walks, must be below 1 / (largest eigenvalue
+	// of the adjacency matrix), and the score every node starts with
+	double alpha = .05;
+	double beta  = 1;
+
+	// Progress reporting and cancellation, optional
+	TaskContext* context = nullptr;
+};
+
+struct PowerIterationResult
+{
+	std::vector<double> scores {};
+
+	int    iterations = 0;
+	double residual   = 0;
+	bool   converged  = false;
+};
+
+// Centralities computed by power iteration over the weighted adjacency matrix.
+// Edge weights are the connection strengths, negative weights count as zero.
+// Scores flow along the directed edges from their first node to the second.
+// Every iteration is a sparse matrix-vector product split between the threads
+// by the number of nonzeros, with inner loops written for the compiler to
+// vectorize. A start vector, such as the result of a previous run on a
+// slightly different graph, cuts the number of iterations down; an empty
+// one starts from the uniform vector
+
+// PageRank of the random walk along the edges, scores sum up to 1
+PowerIterationResult PageRank(const CompactGraph& graph, const PowerIterationSettings& settings = {}, std::span<const double> start = {});
+
+// Katz centrality x = alpha * A * x + beta, normalized to unit length
+PowerIterationResult KatzCentrality(const CompactGraph& graph, const PowerIterationSettings& settings = {}, std::span<const double> start = {});
+
+// Principal eigenvector of the adjacency matrix, normalized to unit length.
+// The iteration runs on A + I, which has the same eigenvectors but does not
+// oscillate on bipartite graphs
+PowerIterationResult EigenvectorCentrality(const CompactGraph& graph, const PowerIterationSettings& settings = {}, std::span<const double> start = {});
+
+//========================================
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+
+//========================================
+
+// Order in which the greedy colouring visits the nodes
+enum class ColoringOrder
+{
+	// Node index order
+	Natural,
+
+	// Highest degree first
+	LargestFirst,
+
+	// Reverse of the order in which nodes of the smallest remaining degree are
+	// removed, uses at most degeneracy + 1 colours
+	SmallestLast
+};
+
+struct Coloring
+{
+	// Colour of every node, adjacent nodes never share one.
+	// Nodes with self loops are coloured as if the loop was not there
+	std::vector<CompactGraph::index_t> colors {};
+
+	// Number of nodes of every colour
+	std::vector<size_t> sizes {};
+
+	// Most speculation rounds any batch took, and the nodes recoloured because of conflicts
+	size_t rounds    = 0;
+	size_t conflicts = 0;
+
+	size_t getCount() const;
+};
+
+// Parallel speculative greedy colouring. Every round, the threads colour their
+// part of the remaining nodes at once, each taking the smallest colour not used
+// by the neighbours it sees. Adjacent nodes coloured concurrently may collide,
+// then the one later in the order is coloured again in the next round
+Coloring GreedyColoring(const CompactGraph& graph, ColoringOrder order = ColoringOrder::SmallestLast);
+
+//========================================
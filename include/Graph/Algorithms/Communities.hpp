@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+#include <Graph/TaskPool.hpp>
+
+//========================================
+
+struct LouvainSettings
+{
+	// Weight of the null model, above 1 favours smaller communities
+	double resolution = 1;
+
+	// A level is kept only if it improves the modularity by at least this much
+	double min_gain = 1e-6;
+
+	// Local moving sweeps per level, they also stop once
+	// fewer than min_moved of the nodes change their community
+	int    max_passes = 16;
+	double min_moved  = 1e-3;
+
+	int max_levels = 32;
+
+	// Progress reporting and cancellation, optional
+	TaskContext* context = nullptr;
+};
+
+struct LouvainLevel
+{
+	size_t communities = 0;
+	double modularity  = 0;
+	int    passes      = 0;
+};
+
+struct Communities
+{
+	// Community index of every node
+	std::vector<CompactGraph::index_t> labels {};
+
+	// Number of nodes in every community
+	std::vector<size_t> sizes {};
+
+	// Modularity of the partition after every level
+	std::vector<LouvainLevel> levels {};
+	double modularity = 0;
+
+	size_t getCount() const;
+};
+
+// Louvain community detection maximizing the weighted modularity. Edge
+// weights are the connection strengths, negative weights count as zero.
+// Nodes are moved between the communities by all threads at once, with the
+// community totals updated atomically, and the communities are then merged
+// into the nodes of the next level. The result depends on the thread
+// interleaving. Communities are numbered in the order of their smallest node
+Communities LouvainCommunities(const CompactGraph& graph, const LouvainSettings& settings = {});
+
+//========================================
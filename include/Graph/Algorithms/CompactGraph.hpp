@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+//========================================
+
+// Immutable compressed sparse row representation of the graph topology.
+// Nodes and edges are addressed by dense indices, which lets the
+// algorithms work on flat arrays instead of chasing object pointers.
+// Directed edges lead from their first node to the second one. Every node
+// has all of its incident arcs, and separate arrays of the arcs that can be
+// followed out of it and into it; without directed edges all three coincide.
+// Copies share the arcs, which never change after construction
+class CompactGraph
+{
+public:
+	using index_t = uint32_t;
+
+	struct EdgeRecord
+	{
+		index_t a;
+		index_t b;
+		int weight;
+		bool directed = false;
+	};
+
+	struct Arc
+	{
+		index_t node;
+		index_t edge;
+	};
+
+	CompactGraph();
+	CompactGraph(size_t node_count, std::span<const EdgeRecord> edges);
+
+	size_t getNodeCount() const;
+	size_t getEdgeCount() const;
+
+	size_t getDegree(index_t node) const;
+	std::span<const Arc> getArcs(index_t node) const;
+
+	// Arcs to the nodes reachable in one step, and from the nodes this one is reachable from
+	std::span<const Arc> getOutArcs(index_t node) const;
+	std::span<const Arc> getInArcs(index_t node) const;
+
+	// Whether any of the edges is directed
+	bool isDirected() const;
+
+	const EdgeRecord& getEdge(index_t edge) const;
+	int getWeight(index_t edge) const;
+
+	bool empty() const;
+
+	// Copy with other edge weights, in the order of the edges. Only the edge
+	// records are copied, the arcs stay shared with this graph
+	CompactGraph reweighted(std::span<const int> weights) const;
+
+private:
+	struct Adjacency
+	{
+		std::vector<size_t> offsets { 0 };
+		std::vector<Arc>    arcs    {};
+
+		std::vector<size_t> out_offsets {};
+		std::vector<Arc>    out_arcs    {};
+		std::vector<size_t> in_offsets  {};
+		std::vector<Arc>    in_arcs     {};
+	};
+
+	size_t m_node_count { 0 };
+
+	std::vector<EdgeRecord> m_edges {};
+	std::shared_ptr<const Adjacency> m_adjacency {};
+
+	bool m_directed { false };
+
+	// Keeps the arcs of every node that can be followed in the given direction
+	void filterArcs(const Adjacency& adjacency, bool outgoing, std::vector<size_t>& offsets, std::vector<Arc>& arcs) const;
+
+};
+
+//========================================
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+
+//========================================
+
+struct Components
+{
+	// Component index of every node
+	std::vector<CompactGraph::index_t> labels {};
+
+	// Number of nodes in every component
+	std::vector<size_t> sizes {};
+
+	size_t getCount() const;
+	bool connected(CompactGraph::index_t a, CompactGraph::index_t b) const;
+};
+
+// Connected components of the graph, found with a lock-free concurrent
+// union-find over the edge list. Edge directions are ignored, so these are
+// the weak components of a directed graph. Components are numbered in the
+// order of their smallest node index
+Components ConnectedComponents(const CompactGraph& graph);
+
+// Strongly connected components: sets of nodes that can all reach each other
+// along the directed edges, undirected edges count as a pair of opposite ones.
+// Found with Tarjan's algorithm, driven by an explicit stack of arc positions
+// instead of recursion, so it is not limited by the depth of the call stack.
+// Components are numbered in the order Tarjan's algorithm completes them,
+// which is a reverse topological order of the condensation: edges between
+// components lead from a higher number to a lower one
+Components StronglyConnectedComponents(const CompactGraph& graph);
+
+//========================================
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+
+//========================================
+
+// Random graph generators. Every generator returns a simple undirected edge
+// list with unit weights, is deterministic for a given seed regardless of the
+// number of threads, and runs in time proportional to the size of its output
+
+// G(n, p): every pair of nodes is connected with probability p. Pairs are
+// visited with geometric skips (Batagelj & Brandes), so only the generated
+// edges cost anything
+std::vector<CompactGraph::EdgeRecord> GenerateGnp(size_t nodes, double probability, uint64_t seed);
+
+// G(n, m): m distinct edges chosen uniformly among all pairs of nodes
+std::vector<CompactGraph::EdgeRecord> GenerateGnm(size_t nodes, size_t edges, uint64_t seed);
+
+// Barabási–Albert preferential attachment: every new node attaches to
+// `attachment` distinct existing nodes chosen proportionally to their degree
+std::vector<CompactGraph::EdgeRecord> GenerateBarabasiAlbert(size_t nodes, size_t attachment, uint64_t seed);
+
+// Watts–Strogatz small world: ring lattice where every node is connected to
+// its `neighbours` nearest nodes, each edge rewired with the given probability
+// to a node it is not adjacent to yet, so that the number of edges stays fixed
+std::vector<CompactGraph::EdgeRecord> GenerateWattsStrogatz(size_t nodes, size_t neighbours, double rewiring, uint64_t seed);
+
+// R-MAT (recursive Kronecker) graph on 2^scale nodes with edge_factor * 2^scale
+// sampled edges. Every edge descends into one of the four adjacency matrix
+// quadrants with probabilities a, b, c and 1 - a - b - c. Node indices are
+// scrambled, self loops and duplicate edges are dropped. Scales outside
+// [rmat_min_scale, rmat_max_scale] give no edges
+constexpr unsigned rmat_min_scale = 1;
+constexpr unsigned rmat_max_scale = 31;
+
+std::vector<CompactGraph::EdgeRecord> GenerateRMat(unsigned scale, size_t edge_factor, double a, double b, double c, uint64_t seed);
+
+//========================================
+
+enum class RandomGraphModel
+{
+	Gnp,
+	Gnm,
+	BarabasiAlbert,
+	WattsStrogatz,
+	RMat
+};
+
+// Parameters of all the models, so that the editor can keep them between generations
+struct RandomGraphSettings
+{
+	RandomGraphModel model = RandomGraphModel::Gnp;
+
+	size_t nodes = 1000;
+
+	// G(n, p) and G(n, m)
+	double probability = .005;
+	size_t edges       = 2500;
+
+	// Barabási–Albert
+	size_t attachment = 2;
+
+	// Watts–Strogatz
+	size_t neighbours = 4;
+	double rewiring   = .1;
+
+	// R-MAT, the defaults are the Graph500 ones
+	unsigned scale       = 10;
+	size_t   edge_factor = 8;
+	double a = .57;
+	double b = .19;
+	double c = .19;
+
+	uint64_t seed = 0;
+
+	size_t getNodeCount() const;
+
+	// Whether the parameters of the model are in the ranges it accepts
+	bool isValid() const;
+};
+
+std::vector<CompactGraph::EdgeRecord> GenerateRandomGraph(const RandomGraphSettings& settings);
+
+//========================================
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+#include <Graph/TaskPool.hpp>
+
+//========================================
+
+struct HyperBallSettings
+{
+	// Every node keeps 2^log2_registers one byte HyperLogLog registers, twice
+	// over for the double buffering. The relative error of the ball sizes is
+	// about 1.04 / sqrt(2^log2_registers)
+	unsigned log2_registers = 6;
+
+	// Limit on the radius of the balls, zero to run until they stop growing
+	size_t max_iterations = 0;
+
+	uint64_t seed = 0;
+
+	// Progress reporting and cancellation, optional
+	TaskContext* context = nullptr;
+};
+
+struct HyperBallResult
+{
+	// Estimated number of node pairs within distance t of each other,
+	// counting ordered pairs and every node with itself
+	std::vector<double> neighbourhood {};
+
+	// Inverse of the average distance to the reachable nodes
+	// and the sum of the inverse distances to the other nodes
+	std::vector<double> closeness {};
+	std::vector<double> harmonic  {};
+
+	// Radius at which the balls stopped growing, a lower bound of the diameter
+	// unless the iteration limit was reached first
+	size_t iterations = 0;
+	bool   converged  = false;
+
+	// Interpolated distance within which the given fraction of the reachable pairs lies
+	double getEffectiveDiameter(double fraction = .9) const;
+};
+
+// HyperBall: approximate neighbourhood function and distance based centralities.
+// Every node holds a HyperLogLog counter of the nodes within distance t, and
+// the counters of radius t + 1 are the register-wise maxima over the neighbours
+// it has arcs to, so on directed graphs the balls hold the reachable nodes.
+// Only the neighbours whose counters changed in the previous iteration are
+// merged, so the iterations get cheaper as the balls saturate
+HyperBallResult HyperBall(const CompactGraph& graph, const HyperBallSettings& settings = {});
+
+//========================================
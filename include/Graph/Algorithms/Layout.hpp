@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+
+//========================================
+
+struct MultilevelLayoutSettings
+{
+	// Desired distance between adjacent nodes
+	float edge_length = 120;
+
+	// Coarsening stops when a level has this few nodes
+	// or when it shrinks the graph by less than min_shrink
+	size_t coarsest_size = 32;
+	float  min_shrink    = .8f;
+
+	// Refinement iterations on the finest and on the coarsest level
+	int finest_iterations   = 60;
+	int coarsest_iterations = 300;
+
+	uint32_t seed = 0;
+};
+
+// Multilevel force-directed layout in the spirit of sfdp/FM³. The graph is
+// coarsened by heavy edge matching with star collapse of unmatched nodes,
+// the coarsest level is laid out from scratch, and the positions are then
+// prolonged and refined level by level with a grid accelerated spring-electrical
+// model. Returned positions are indexed by the node indices of the graph
+std::vector<sf::Vector2f> MultilevelLayout(const CompactGraph& graph, const MultilevelLayoutSettings& settings = {});
+
+//========================================
+
+struct SpectralLayoutSettings
+{
+	// Desired average distance between adjacent nodes
+	float edge_length = 120;
+
+	// Size of the Krylov subspace built between restarts
+	size_t krylov_dimension = 24;
+
+	int    max_restarts = 16;
+	double tolerance    = 1e-4;
+
+	uint32_t seed = 0;
+};
+
+// Spectral layout: coordinates are the eigenvectors of the weighted graph
+// Laplacian belonging to its 2nd and 3rd smallest eigenvalues. They are found
+// with a restarted Lanczos iteration on the shifted operator (sigma*I - L),
+// whose sparse products are computed in parallel. The iteration is started
+// from eigenvectors of a coarsened graph, which keeps the subspace small
+// on large graphs where the small eigenvalues are poorly separated
+std::vector<sf::Vector2f> SpectralLayout(const CompactGraph& graph, const SpectralLayoutSettings& settings = {});
+
+//========================================
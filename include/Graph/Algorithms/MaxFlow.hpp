@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+
+//========================================
+
+struct MaxFlowResult
+{
+	int64_t value = 0;
+
+	// Nodes on the source side of the minimum cut
+	std::vector<bool> source_side {};
+
+	// Edges crossing the minimum cut, their capacities sum up to the flow value
+	std::vector<CompactGraph::index_t> cut_edges {};
+
+	// Operation counts
+	size_t pushes          = 0;
+	size_t relabels        = 0;
+	size_t global_relabels = 0;
+	size_t gap_nodes       = 0;
+
+	// Time spent in every phase, in milliseconds
+	double init_time           = 0;
+	double discharge_time      = 0;
+	double global_relabel_time = 0;
+	double cut_time            = 0;
+};
+
+// Maximum flow value and minimum cut between src and dst. Edge weights are the
+// capacities, in both directions for undirected edges and from the first node
+// to the second for directed ones, negative weights count as zero. Solved with
+// highest-label push-relabel using periodic global relabelling by a backward
+// breadth-first search from the sink and the gap heuristic. Only the first
+// phase is run: it yields the flow value and the cut, the preflow is not
+// converted back into a flow
+MaxFlowResult MaximumFlow(const CompactGraph& graph, CompactGraph::index_t src, CompactGraph::index_t dst);
+
+//========================================
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+#include <Graph/Generator.hpp>
+
+//========================================
+
+// One change to the state of a search, in the order the search makes it
+struct SearchStep
+{
+	static constexpr auto no_edge = std::numeric_limits<CompactGraph::index_t>::max();
+
+	enum class Kind
+	{
+		// The node joined the frontier, or got closer while on it
+		Discover,
+
+		// The node left the frontier for good
+		Settle
+	};
+
+	Kind kind;
+	CompactGraph::index_t node;
+
+	// Edge the node was reached by, no_edge for the source
+	CompactGraph::index_t edge;
+
+	// Hops or weight from the source, the visiting order for depth-first search
+	int64_t distance;
+};
+
+// Searches that stop after every step, for animating them a few steps per
+// frame. They run sequentially and are far slower than the searches built
+// for speed. The graph must outlive the generator, and directed edges are
+// only followed forwards
+
+Generator<SearchStep> BreadthFirstSteps(const CompactGraph& graph, CompactGraph::index_t src);
+
+// Nodes are settled once all of their descendants are
+Generator<SearchStep> DepthFirstSteps(const CompactGraph& graph, CompactGraph::index_t src);
+
+// Negative weights count as zero, like in ShortestPath
+Generator<SearchStep> DijkstraSteps(const CompactGraph& graph, CompactGraph::index_t src);
+
+//========================================
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+
+//========================================
+
+enum class PathStrategy
+{
+	// Fewest edges, direction-optimising breadth-first search
+	BreadthFirst,
+
+	// Least weight, Dijkstra's algorithm with a binary heap
+	Dijkstra,
+
+	// Least weight, Dijkstra's algorithm run from both ends until the
+	// searches meet, backwards from dst along the incoming arcs
+	BidirectionalDijkstra
+};
+
+// Work done by a path search, the same counters for every strategy
+struct SearchStats
+{
+	// Wall time in milliseconds
+	double time = 0;
+
+	// Nodes whose distance became final, and arcs looked at from them
+	size_t settled = 0;
+	size_t relaxed = 0;
+
+	// Heap operations, or queue operations for the breadth-first search.
+	// The heaps keep stale entries instead of decreasing keys
+	size_t pushes = 0;
+	size_t pops   = 0;
+
+	// Largest heap, or largest level of the breadth-first search
+	size_t peak_frontier = 0;
+};
+
+// Path through a compact graph. edges[i] connects nodes[i] and nodes[i + 1]
+struct CompactPath
+{
+	std::vector<CompactGraph::index_t> nodes {};
+	std::vector<CompactGraph::index_t> edges {};
+
+	SearchStats stats {};
+
+	bool empty() const;
+	int getWeight(const CompactGraph& graph) const;
+};
+
+// Shortest path from src to dst that follows the directed edges forwards,
+// empty if dst is unreachable. The weighted strategies count negative
+// weights as zero
+CompactPath ShortestPath(const CompactGraph& graph, CompactGraph::index_t src, CompactGraph::index_t dst, PathStrategy strategy = PathStrategy::BreadthFirst);
+
+// Shortest paths from one source to every node, as the tree of the arcs the
+// nodes were reached by
+struct ShortestPathTree
+{
+	static constexpr auto unreachable = std::numeric_limits<int64_t>::max();
+
+	// Hops or weight from the source, unreachable for the nodes not reached
+	std::vector<int64_t> distances {};
+
+	// Arc every reached node was reached by, the edge of the source's is none
+	std::vector<CompactGraph::Arc> parents {};
+
+	SearchStats stats {};
+
+	bool reached(CompactGraph::index_t node) const;
+
+	// Path from the source to node, in time linear in its length. Empty
+	// when node is not reached
+	CompactPath getPath(CompactGraph::index_t node) const;
+};
+
+// Searches the whole reachable part of the graph instead of stopping at a
+// destination. The bidirectional strategy has no single destination to meet
+// at and builds the same tree as Dijkstra
+ShortestPathTree ShortestPaths(const CompactGraph& graph, CompactGraph::index_t src, PathStrategy strategy = PathStrategy::BreadthFirst);
+
+//========================================
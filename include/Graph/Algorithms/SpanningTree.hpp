@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+
+//========================================
+
+enum class SpanningForestMethod
+{
+	// Borůvka on large graphs when several threads are available, Kruskal otherwise
+	Automatic,
+	Boruvka,
+	Kruskal
+};
+
+struct SpanningForest
+{
+	// Indices of the edges in the forest
+	std::vector<CompactGraph::index_t> edges {};
+
+	int64_t weight = 0;
+
+	// Number of trees, one per connected component
+	size_t trees = 0;
+
+	// Number of Borůvka rounds, zero for Kruskal
+	size_t rounds = 0;
+};
+
+// Minimum spanning forest. Edges of equal weight are ordered by their index,
+// so both methods return the same forest.
+//
+// Borůvka: every round each component picks its lightest outgoing edge in
+// parallel, the picked edges are merged with a concurrent union-find and the
+// edges inside a component are filtered out.
+// Kruskal: edges are sorted by weight with a parallel radix sort and then
+// added in order unless they close a cycle
+SpanningForest MinimumSpanningForest(const CompactGraph& graph, SpanningForestMethod method = SpanningForestMethod::Automatic);
+
+//========================================
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+
+//========================================
+
+struct Triangles
+{
+	// Number of triangles every node belongs to
+	std::vector<uint64_t> nodes {};
+
+	// Fraction of the pairs of neighbours of every node that are adjacent,
+	// zero for the nodes with fewer than two neighbours
+	std::vector<double> clustering {};
+
+	uint64_t total = 0;
+
+	// Mean of the local clustering coefficients,
+	// and three times the triangles per connected triple of nodes
+	double average_clustering = 0;
+	double transitivity       = 0;
+};
+
+// Triangle counts and clustering coefficients of the simple graph underlying
+// the given one, parallel edges and self loops are ignored. Every edge is
+// directed from the lower degree end to the higher one, which bounds the
+// out-degrees by sqrt(2m), and each triangle is found once by intersecting
+// the sorted out-neighbour lists of the ends of one of its edges
+Triangles CountTriangles(const CompactGraph& graph);
+
+//========================================
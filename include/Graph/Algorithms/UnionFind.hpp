@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+#include <Graph/Parallel.hpp>
+
+//========================================
+
+// Lock-free union-find that can be used from several threads at once.
+// A root is only ever linked below a smaller index, so parents never
+// exceed their children and the links can not form a cycle. Linking is
+// a single compare-and-swap on the root, which is retried when another
+// thread has linked the same root in the meantime
+class ConcurrentUnionFind
+{
+public:
+	using index_t = CompactGraph::index_t;
+
+	explicit ConcurrentUnionFind(size_t size):
+		m_parents(size)
+	{
+		ParallelFor(
+			size,
+			[&](size_t i)
+			{
+				m_parents[i].store(static_cast<index_t>(i), std::memory_order_relaxed);
+			}
+		);
+	}
+
+	index_t find(index_t node)
+	{
+		while (true)
+		{
+			index_t parent = m_parents[node].load(std::memory_order_relaxed);
+			if (parent == node)
+				return node;
+
+			// Path halving, losing the race only skips the shortcut
+			index_t grandparent = m_parents[parent].load(std::memory_order_relaxed);
+			if (parent != grandparent)
+				m_parents[node].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+
+			node = grandparent;
+		}
+	}
+
+	// Returns false if the nodes were in the same set already
+	bool unite(index_t a, index_t b)
+	{
+		while (true)
+		{
+			a = find(a);
+			b = find(b);
+
+			if (a == b)
+				return false;
+
+			if (a < b)
+				std::swap(a, b);
+
+			index_t expected = a;
+			if (m_parents[a].compare_exchange_strong(expected, b, std::memory_order_relaxed))
+				return true;
+		}
+	}
+
+	size_t size() const
+	{
+		return m_parents.size();
+	}
+
+private:
+	std::vector<std::atomic<index_t>> m_parents;
+
+};
+
+//========================================
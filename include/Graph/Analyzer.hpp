@@ -0,0 +1,164 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Graph/Objects/ObjectManager.hpp>
+#include <Graph/SearchAnimation.hpp>
+#include <Graph/Algorithms/Betweenness.hpp>
+#include <Graph/Algorithms/Centrality.hpp>
+#include <Graph/Algorithms/Coloring.hpp>
+#include <Graph/Algorithms/Communities.hpp>
+#include <Graph/Algorithms/HyperBall.hpp>
+#include <Graph/Algorithms/SpanningTree.hpp>
+#include <Graph/Algorithms/Triangles.hpp>
+
+//========================================
+
+// Runs the graph algorithms on the objects of a manager, shows their
+// results in windows and visualizes them on the nodes and edges
+class Analyzer
+{
+public:
+	explicit Analyzer(ObjectManager& manager);
+
+	// Items of the Analysis menu
+	void showMenu();
+
+	// Result windows
+	void processInterface();
+
+	// Advances the animated search, once per frame
+	void update();
+	bool isAnimating() const;
+
+	void findSpanningForest();
+	void findCommunities();
+
+private:
+	ObjectManager& m_object_manager;
+
+	SearchAnimation m_search_animation;
+
+	bool m_components_show = false;
+	bool m_components_strong = false;
+	Components m_components {};
+	std::vector<size_t> m_components_order {};
+	std::vector<sf::Color> m_components_colors {};
+	float m_components_time = 0;
+	size_t m_components_version = -1;
+
+	// Ids of the nodes the labels belong to, the nodes are only coloured
+	// again when a label changes or a recolour has been asked for
+	std::vector<size_t> m_components_ids {};
+	bool m_components_recolor = false;
+
+	bool m_bfs_show = false;
+	std::string m_bfs_source {};
+	std::string m_bfs_error {};
+	std::vector<size_t> m_bfs_level_sizes {};
+	size_t m_bfs_bottom_up_levels = 0;
+	float m_bfs_time = 0;
+
+	bool m_msf_show = false;
+	int m_msf_method = static_cast<int>(SpanningForestMethod::Automatic);
+	SpanningForest m_msf {};
+	float m_msf_time = 0;
+
+	bool m_communities_show = false;
+	LouvainSettings m_louvain_settings {};
+	std::vector<LouvainLevel> m_communities_levels {};
+	size_t m_communities_count = 0;
+	float m_communities_time = 0;
+
+	enum class StatisticsColoring
+	{
+		None,
+		Triangles,
+		Clustering
+	};
+
+	bool m_statistics_show = false;
+	int m_statistics_coloring = static_cast<int>(StatisticsColoring::None);
+	Triangles m_triangles {};
+	std::shared_ptr<const ObjectGraph> m_statistics_graph {};
+	size_t m_max_degree = 0;
+	float m_statistics_time = 0;
+	size_t m_statistics_version = -1;
+
+	bool m_coloring_show = false;
+	int m_coloring_order = static_cast<int>(ColoringOrder::SmallestLast);
+	size_t m_coloring_count = 0;
+	size_t m_coloring_rounds = 0;
+	size_t m_coloring_conflicts = 0;
+	float m_coloring_time = 0;
+
+	enum class CentralityMethod
+	{
+		Betweenness,
+		PageRank,
+		Katz,
+		Eigenvector,
+		Closeness,
+		Harmonic
+	};
+
+	bool m_centrality_show = false;
+	int m_centrality_method = static_cast<int>(CentralityMethod::Betweenness);
+	BetweennessSettings m_betweenness_settings {};
+	PowerIterationSettings m_power_iteration_settings {};
+	HyperBallSettings m_hyperball_settings {};
+
+	// Neighbourhood function of the last HyperBall run
+	std::vector<float> m_neighbourhood {};
+	double m_effective_diameter = 0;
+
+	// Power iterations start from the previous result of the same method,
+	// which survives the edits of the graph as it is keyed by the node ids.
+	// Unlike the addresses, those are never given to another node
+	bool m_warm_start = true;
+	int m_warm_start_method = -1;
+	std::unordered_map<size_t, double> m_warm_start_scores {};
+
+	// Scores of the last run and the snapshot they belong to
+	std::vector<double> m_centrality {};
+	std::shared_ptr<const ObjectGraph> m_centrality_graph {};
+
+	// Top nodes by score, in the order chosen in the table
+	struct CentralityRow
+	{
+		size_t rank;
+		CompactGraph::index_t node;
+	};
+
+	std::vector<CentralityRow> m_centrality_rows {};
+	std::string m_centrality_info {};
+	float m_centrality_time = 0;
+
+	// Follows the edits of the graph without recolouring when recolor is not set
+	void findComponents(bool recolor = true);
+	void findColoring();
+	void updateStatistics();
+	void applyStatisticsColoring();
+	void showBreadthFirstSearch();
+	void runBreadthFirstSearch();
+	void runCentrality();
+
+	// Sorts the top of the new scores into the table
+	void rankCentrality(std::shared_ptr<const ObjectGraph> graph);
+
+	std::vector<double> getWarmStart(const ObjectGraph& graph) const;
+	void showCentralityTable();
+
+	// Scales and colours nodes by their scores, and edges by theirs if given
+	void applyScores(const ObjectGraph& graph, std::span<const double> node_scores, std::span<const double> edge_scores = {});
+
+	void resetAppearance();
+	void clearHighlight();
+
+};
+
+//========================================
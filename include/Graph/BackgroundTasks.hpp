@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Graph/TaskPool.hpp>
+
+//========================================
+
+// Algorithms running on the default task pool while the editor keeps drawing.
+// Their results are handed back to the UI thread by poll(), once per frame,
+// so only the UI thread ever touches the objects
+class BackgroundTasks
+{
+public:
+	BackgroundTasks() = default;
+	BackgroundTasks(const BackgroundTasks& copy) = delete;
+
+	// Tasks still running are cancelled, their results dropped
+	~BackgroundTasks();
+
+	// Runs work(context) on the pool, then apply(result, milliseconds) on the
+	// UI thread unless the task was cancelled. A task with the name of a
+	// running one replaces it
+	template<typename Work, typename Apply>
+	void run(std::string_view name, Work work, Apply apply);
+
+	// Applies the results of the finished tasks, returns whether there were any
+	bool poll();
+
+	bool isRunning(std::string_view name) const;
+	bool empty() const;
+
+	// Whether a task has finished since the last poll, checked by the idle editor
+	bool hasFinished() const;
+
+	void cancel(std::string_view name);
+	void cancelAll();
+
+	// Progress bars and cancel buttons of the running tasks
+	void processInterface();
+
+private:
+	struct Task
+	{
+		std::string name {};
+		TaskContext context {};
+
+		// Set by the worker once complete is ready to be called
+		std::atomic<bool> finished = false;
+		std::move_only_function<void()> complete {};
+		std::string error {};
+	};
+
+	std::vector<std::shared_ptr<Task>> m_tasks {};
+
+	// Message of the last task that failed, until it is dismissed
+	std::string m_error {};
+
+};
+
+//========================================
+
+template<typename Work, typename Apply>
+void BackgroundTasks::run(std::string_view name, Work work, Apply apply)
+{
+	cancel(name);
+
+	auto task = std::make_shared<Task>();
+	task->name = name;
+	m_tasks.push_back(task);
+
+	TaskPool::Default().submit(
+		[task, work = std::move(work), apply = std::move(apply)]() mutable
+		{
+			auto start = std::chrono::steady_clock::now();
+
+			try
+			{
+				auto result = work(task->context);
+				float time = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+				task->complete = [apply = std::move(apply), result = std::move(result), time]() mutable
+				{
+					apply(result, time);
+				};
+			}
+
+			catch (const std::exception& exception)
+			{
+				task->error = exception.what();
+			}
+
+			task->finished.store(true, std::memory_order_release);
+		}
+	);
+}
+
+//========================================
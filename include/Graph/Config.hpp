@@ -12,14 +12,65 @@ namespace config
 
 	const sf::Color edge_default_color(0, 210, 163);
 	const sf::Color edge_path_color(255, 45, 92);
+	const sf::Color edge_highlight_color(255, 200, 40);
+	const sf::Color edge_cut_color(190, 90, 255);
 	const float     edge_default_thickness = 4;
 	const int       edge_default_weight = 1;
+	const float     edge_arrow_size = 14;
 
 	const sf::Color background_color(30, 31, 34);
 	const sf::Color background_dot_color(45, 46, 51);
 	const float     background_dot_radius = 2;
 	const float     background_dot_distance = 100;
 
+	const sf::Color centrality_color(255, 80, 40);
+	const float     centrality_max_scale = 3;
+	const size_t    centrality_table_size = 100;
+	const unsigned  hyperball_log2_registers_min = 4;
+	const unsigned  hyperball_log2_registers_max = 12;
+	const float     neighbourhood_plot_height = 80;
+
+	const size_t    profiler_history = 240;
+	const float     profiler_frame_budget = 1000.f / 60;
+	const float     profiler_plot_height = 80;
+	const float     profiler_flame_row_height = 20;
+	const size_t    profiler_trace_max_events = 4000000;
+	const char      profiler_trace_filename[] = "trace.json";
+
+	const size_t    path_history_size = 16;
+	const float     path_strategy_combo_width = 200;
+
+	const float     task_progress_width = 150;
+
+	// Frames drawn after the last input before the editor may idle, so that
+	// ImGui settles, and the longest the idle editor waits between frames
+	const unsigned  idle_settle_frames = 3;
+	const float     idle_timeout = .5f;
+	const float     idle_task_timeout = .1f;
+	const float     idle_poll_interval = .005f;
+
+	const sf::Color animation_frontier_color(255, 160, 40);
+	const sf::Color animation_visited_color(90, 140, 255);
+	const float     animation_default_speed = 20;
+	const float     animation_max_speed = 1000000;
+	const float     animation_target_frame_time = 1000.f / 60;
+	const float     animation_min_budget = .25f;
+	const float     animation_max_budget = 8;
+
+	const unsigned  tile_size = 512;
+	const unsigned  tile_antialiasing_level = 8;
+	const size_t    tile_cache_max_tiles = 64;
+	const size_t    tile_cache_min_objects = 2000;
+	const size_t    tile_cache_max_changes = 4096;
+
+	const float     layout_edge_length = 120;
+	const float     layout_animation_duration = .75f;
+
+	const size_t    generator_max_nodes = 1000000;
+	const size_t    generator_max_grid_side = 1000;
+	const unsigned  rmat_scale_min = 1;
+	const unsigned  rmat_scale_max = 20;
+
 	const std::filesystem::path resources_path = "./resources";
 	const std::filesystem::path font_filename = "fonts/CascadiaMono.ttf";
 
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+//========================================
+
+// Coroutine that produces a sequence of values lazily. The body runs up to
+// its next co_yield whenever next() is called, so a long computation can be
+// spread over many frames and dropped halfway by destroying the generator
+template<typename T>
+class Generator
+{
+public:
+	struct promise_type
+	{
+		std::optional<T> value {};
+		std::exception_ptr exception {};
+
+		Generator get_return_object()
+		{
+			return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		std::suspend_always final_suspend() noexcept { return {}; }
+
+		std::suspend_always yield_value(T yielded)
+		{
+			value = std::move(yielded);
+			return {};
+		}
+
+		void return_void() {}
+
+		void unhandled_exception()
+		{
+			exception = std::current_exception();
+		}
+	};
+
+	Generator() = default;
+	Generator(const Generator& copy) = delete;
+	Generator(Generator&& generator) noexcept;
+	~Generator();
+
+	Generator& operator=(const Generator& copy) = delete;
+	Generator& operator=(Generator&& generator) noexcept;
+
+	// Runs the body up to its next value, returns false once it has finished
+	bool next();
+
+	// Value of the last successful next()
+	const T& get() const;
+
+	bool done() const;
+	explicit operator bool() const;
+
+private:
+	explicit Generator(std::coroutine_handle<promise_type> handle);
+
+	std::coroutine_handle<promise_type> m_handle {};
+
+};
+
+//========================================
+
+template<typename T>
+Generator<T>::Generator(std::coroutine_handle<promise_type> handle):
+	m_handle(handle)
+{}
+
+template<typename T>
+Generator<T>::Generator(Generator&& generator) noexcept:
+	m_handle(std::exchange(generator.m_handle, nullptr))
+{}
+
+template<typename T>
+Generator<T>::~Generator()
+{
+	if (m_handle)
+		m_handle.destroy();
+}
+
+template<typename T>
+Generator<T>& Generator<T>::operator=(Generator&& generator) noexcept
+{
+	if (this != &generator)
+	{
+		if (m_handle)
+			m_handle.destroy();
+
+		m_handle = std::exchange(generator.m_handle, nullptr);
+	}
+
+	return *this;
+}
+
+template<typename T>
+bool Generator<T>::next()
+{
+	if (done())
+		return false;
+
+	m_handle.promise().value.reset();
+	m_handle.resume();
+
+	if (auto exception = m_handle.promise().exception)
+		std::rethrow_exception(exception);
+
+	return !m_handle.done();
+}
+
+template<typename T>
+const T& Generator<T>::get() const
+{
+	return *m_handle.promise().value;
+}
+
+template<typename T>
+bool Generator<T>::done() const
+{
+	return !m_handle || m_handle.done();
+}
+
+template<typename T>
+Generator<T>::operator bool() const
+{
+	return static_cast<bool>(m_handle);
+}
+
+//========================================
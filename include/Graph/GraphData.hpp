@@ -0,0 +1,55 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+
+//========================================
+
+// Plain graph description that can be stored to and loaded from a file
+// without any of the editor objects. Files starting with the binary
+// signature are read as binary, anything else is read as a text edge list:
+//
+//   # comment
+//   A B 5     edge between nodes A and B with weight 5
+//   A C       edge with weight 1
+//   A -> E 2  directed edge from A to E with weight 2
+//   D         isolated node
+//
+// Text edge lists carry no node positions
+class GraphData
+{
+public:
+	std::vector<std::string>             labels    {};
+	std::vector<sf::Vector2f>            positions {};
+	std::vector<CompactGraph::EdgeRecord> edges    {};
+
+	bool loadFromFile(const std::filesystem::path& path);
+
+	// Files with the .bin extension are stored as binary, others as text edge lists
+	bool saveToFile(const std::filesystem::path& path) const;
+
+	bool hasPositions() const;
+
+	CompactGraph buildGraph() const;
+	std::optional<CompactGraph::index_t> findNode(std::string_view label) const;
+
+	void clear();
+
+private:
+	// The size is the number of bytes in the stream after the signature
+	bool loadBinary(std::istream& stream, uint64_t size);
+	bool loadText(std::istream& stream);
+
+	bool saveBinary(std::ostream& stream) const;
+	bool saveText(std::ostream& stream) const;
+
+};
+
+//========================================
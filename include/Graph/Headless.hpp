@@ -0,0 +1,13 @@
+#pragma once
+
+//========================================
+
+// Runs the command line interface that works on graph files without
+// creating a window. Commands are executed in the order they are given:
+//
+//   graph --headless --load g.bin --layout multilevel --save out.bin --shortest A B
+//
+// Returns the process exit code
+int RunHeadless(int argc, char** argv);
+
+//========================================
@@ -12,8 +12,6 @@ class Edge: public Object
 public:
 	Edge();
 
-	void onAdded(ObjectManager* manager);
-
 	void setThickness(float thickness);
 	float getThickness() const;
 
@@ -26,22 +24,48 @@ public:
 	void setNodeB(Node* node);
 	Node* getNodeB() const;
 
+	// Sets both ends without notifying the nodes, bulk insertion
+	// fills their adjacency lists by itself
+	void attach(Node* a, Node* b);
+
 	void setWeight(int weight);
 	int getWeight() const;
 
+	// Directed edges lead from node A to node B only
+	void setDirected(bool directed);
+	bool isDirected() const;
+
+	// Swaps the ends, which turns a directed edge around
+	void reverse();
+
+	// Whether the edge can be followed starting from the given end
+	bool leadsFrom(Node* node) const;
+
 	Node* opposite(Node* node) const;
 	bool isConnectedTo(Node* node) const;
 
-	void draw() override;
+	void draw(sf::RenderTarget& target) override;
+	sf::FloatRect getBounds() override;
 	bool onEvent(const sf::Event& event) override;
 	void onDelete() override;
 
 	void setPathIndication(bool enable);
 
+	// Marks the edge as a part of the minimum cut of a maximum flow query
+	void setCutIndication(bool enable);
+
+	// Called before the ends move or change their size
+	void invalidateGeometry();
+
+	// Marks the edge as a part of an analysis result, path and cut indications take precedence
+	void setHighlight(bool enable);
+	bool isHighlighted() const;
+
 private:
 	sf::Color m_color     = config::edge_default_color;
 	float     m_thickness = config::edge_default_thickness;
 	int       m_weight    = config::edge_default_weight;
+	bool      m_directed  = false;
 
 	bool m_connecting = false;
 	sf::Vector2f m_connecting_end {};
@@ -49,13 +73,29 @@ private:
 	Node* m_node_a = nullptr;
 	Node* m_node_b = nullptr;
 	bool m_path_indication = false;
+	bool m_cut_indication = false;
+	bool m_highlight = false;
 
 	sf::RectangleShape m_rectangle {};
+	sf::ConvexShape    m_arrow     {};
 	sf::Text           m_text      {};
 
+	// The shapes are only updated when something they depend on has changed,
+	// their placement when the ends move and their colours otherwise
+	bool m_geometry_dirty   = true;
+	bool m_appearance_dirty = true;
+	float m_length = 0;
+	sf::FloatRect m_bounds {};
+
 	bool intersect(const sf::Vector2f& point) const override;
 	const char* getName() const override;
 	void onPropertiesShow();
+	void onHoverChanged() override;
+
+	void invalidateAppearance();
+
+	void updateGeometry();
+	void updateAppearance();
 
 	sf::Vector2f getAPosition() const;
 	sf::Vector2f getBPosition() const;
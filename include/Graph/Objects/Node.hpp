@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -34,14 +35,17 @@ public:
 	int getPriority() const override;
 	Edge* isAdjacent(Node* node) const;
 
-	void onAdded(ObjectManager* manager) override;
-	void draw() override;
+	void draw(sf::RenderTarget& target) override;
+	sf::FloatRect getBounds() override;
 	bool onEvent(const sf::Event& event) override;
 
 	void onDelete() override;
 	void onEdgeConnected(Edge* edge);
 	void onEdgeDisconnected(Edge* edge);
 
+	// Appends edges that are known not to be connected yet, skipping the duplicate check
+	void onEdgesConnected(std::span<Edge* const> edges);
+
 	const std::vector<Edge*>& getConnectedEdges() const;
 
 private:
@@ -59,9 +63,24 @@ private:
 
 	std::vector<Edge*> m_connected_edges {};
 
+	// The circle and label are only updated when something they depend on has changed
+	bool m_geometry_dirty   = true;
+	bool m_appearance_dirty = true;
+	sf::FloatRect m_bounds {};
+
+	// Marks the node and its edges, which end at its position and radius.
+	// Called before the change
+	void invalidateGeometry();
+	void invalidateAppearance();
+
+	void updateGeometry();
+	void updateAppearance();
+
 	bool intersect(const sf::Vector2f& point) const override;
 	const char* getName() const override;
 
+	void onHoverChanged() override;
+
 	void onPropertiesShow() override;
 	bool onRMBMenuShow() override;
 
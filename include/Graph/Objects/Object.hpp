@@ -14,7 +14,11 @@ public:
 	bool isHovered() const;
 	virtual const char* getName() const = 0;
 
-	virtual void draw() = 0;
+	virtual void draw(sf::RenderTarget& target) = 0;
+
+	// Area of everything draw() covers, with the shapes brought up to date
+	virtual sf::FloatRect getBounds() = 0;
+
 	virtual bool onEvent(const sf::Event& event);
 	virtual void onAdded(ObjectManager* manager);
 	virtual void onDelete();
@@ -41,6 +45,10 @@ protected:
 	virtual bool intersect(const sf::Vector2f& point) const = 0;
 	virtual void onHoverChanged();
 
+	// Called before every change to how the object looks, so that the
+	// manager can draw the area it covers again
+	void requestRedraw();
+
 	virtual bool onRMBMenuShow();
 	virtual void onPropertiesShow();
 
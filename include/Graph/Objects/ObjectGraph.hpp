@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+#include <Graph/Objects/Node.hpp>
+#include <Graph/Objects/Edge.hpp>
+
+//========================================
+
+class ObjectManager;
+
+// Compact graph built from the objects of an ObjectManager, which also
+// remembers what node and edge objects stand behind each index. Snapshots
+// built from a previous one share whatever has not changed since
+class ObjectGraph: public CompactGraph
+{
+public:
+	ObjectGraph();
+
+	static ObjectGraph Build(ObjectManager& manager);
+
+	// Same nodes as previous, the edges are read again
+	static ObjectGraph Rebuild(ObjectManager& manager, const ObjectGraph& previous);
+
+	// Same nodes and edges as previous, only the weights are read again
+	static ObjectGraph Reweight(const ObjectGraph& previous);
+
+	Node* getNodeObject(index_t node) const;
+	Edge* getEdgeObject(index_t edge) const;
+
+	const std::vector<Node*>& getNodeObjects() const;
+	const std::vector<Edge*>& getEdgeObjects() const;
+
+	bool contains(Node* node) const;
+	index_t indexOf(Node* node) const;
+
+	std::vector<sf::Vector2f> getPositions() const;
+
+private:
+	struct NodeTable
+	{
+		std::vector<Node*> objects {};
+		std::unordered_map<Node*, index_t> indices {};
+	};
+
+	ObjectGraph(CompactGraph graph);
+
+	std::shared_ptr<const NodeTable> m_nodes {};
+	std::shared_ptr<const std::vector<Edge*>> m_edge_objects {};
+
+	// Edges between the nodes of the table, skipping the one being connected
+	static ObjectGraph Connect(ObjectManager& manager, std::shared_ptr<const NodeTable> nodes);
+
+};
+
+//========================================
@@ -1,15 +1,40 @@
 #pragma once
 
 #include <concepts>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
 #include <vector>
 #include <set>
+#include <string>
+#include <unordered_set>
 
 #include <SFML/Graphics.hpp>
 
 #include <Graph/Objects/Object.hpp>
 #include <Graph/Objects/Node.hpp>
 #include <Graph/Objects/Edge.hpp>
+#include <Graph/Objects/ObjectGraph.hpp>
+#include <Graph/Algorithms/Components.hpp>
+#include <Graph/Algorithms/MaxFlow.hpp>
 #include <Graph/Path.hpp>
+#include <Graph/GraphData.hpp>
+#include <Graph/Profiler.hpp>
+#include <Graph/BackgroundTasks.hpp>
+#include <Graph/TileCache.hpp>
+
+//========================================
+
+// What a change to the graph touched, from the least to the most of the
+// snapshot that has to be built again
+enum class GraphChange
+{
+	Weights,
+	Edges,
+	Nodes
+};
 
 //========================================
 
@@ -28,11 +53,21 @@ public:
 	void setFont(sf::Font* font);
 	sf::Font* getFont() const;
 
+	// Times the drawing of every object type, optional
+	void setProfiler(Profiler* profiler);
+
+	// Large graphs are drawn through a cache of rasterised tiles
+	void setTiledRendering(bool enable);
+	bool isTiledRendering() const;
+
 	void edgeConnectionStart(Node* node);
 	bool edgeConnectionComplete(Node* node = nullptr);
 
 	void pathSearchSrc(Node* node);
 	void pathSearchDst(Node* node);
+
+	// Completes the source selection of pathSearchSrc with a maximum flow query
+	void maxFlowDst(Node* node);
 	void cancelPathSearch();
 
 	Node* getPathSrc();
@@ -52,6 +87,60 @@ public:
 
 	void clear();
 
+	// Bulk insertion. Objects are inserted next to the others of the same
+	// priority and the adjacency lists are filled in a single pass, without
+	// the per edge connection logic of Edge::setNodeA/setNodeB. Insertion only
+	// tells every object its manager, the labels take the shared font once
+	// they are first drawn
+	std::vector<Node*> addNodes(size_t count);
+
+	// Endpoints of the edge records are indices into nodes. The edges must not
+	// be connected to the nodes already
+	std::vector<Edge*> addEdges(std::span<Node* const> nodes, std::span<const CompactGraph::EdgeRecord> edges);
+
+	// Adds node_count new nodes connected by the given edges, whose endpoints
+	// are indices into the returned nodes
+	std::vector<Node*> addGraph(size_t node_count, std::span<const CompactGraph::EdgeRecord> edges);
+
+	bool saveToFile(const std::filesystem::path& path);
+
+	// Replaces the graph with the one stored in the file. Like clear(),
+	// the replacement takes effect on the next cleanup
+	bool loadFromFile(const std::filesystem::path& path);
+
+	// Compact snapshot of the current graph and its connected components.
+	// Both are rebuilt on demand after the graph has changed
+	const ObjectGraph& getGraph();
+	const Components& getComponents();
+
+	// The same snapshot, immutable and kept alive for the background tasks
+	// reading it. Objects removed from the graph are only freed once every
+	// snapshot taken before their removal is gone
+	std::shared_ptr<const ObjectGraph> getGraphSnapshot();
+
+	// Whether the snapshot still describes the graph
+	bool isCurrent(const ObjectGraph& graph) const;
+
+	// Called whenever nodes or edges are added, removed, reconnected or reweighted
+	void onGraphChanged(GraphChange change = GraphChange::Nodes);
+	size_t getGraphVersion() const;
+
+	// Changes with the nodes and edges only, reweighting leaves it as it is
+	size_t getTopologyVersion() const;
+
+	BackgroundTasks& getTasks();
+
+	// Runs work(graph, context) on a snapshot of the current graph in the
+	// background, then apply(graph, result, milliseconds) on the UI thread.
+	// The objects of the snapshot are still alive by then, but the graph may
+	// have changed, see isCurrent
+	template<typename Work, typename Apply>
+	void runGraphTask(std::string_view name, Work work, Apply apply);
+
+	void applyLayout(const ObjectGraph& graph, const std::vector<sf::Vector2f>& positions, bool animate = true);
+	bool isAnimating() const;
+
+	void update();
 	void drawObjects();
 	bool onEvent(const sf::Event& event);
 	void processInterface();
@@ -59,6 +148,10 @@ public:
 
 	void onNodeDeleted(Node* node);
 	void onEdgeDeleted(Edge* edge);
+	void onNodeHovered(Node* node, bool hovered);
+
+	// Called by the objects before they change how they look
+	void onObjectChanging(Object* object);
 
 	size_t size() const;
 	container::iterator begin();
@@ -67,12 +160,15 @@ public:
 private:
 	sf::RenderWindow* m_window = nullptr;
 	sf::Font* m_font = nullptr;
+	Profiler* m_profiler = nullptr;
 
 	container m_objects {};
 
 	std::vector<container::iterator> m_deleted_objects {};
 	bool m_clear = false;
 
+	std::optional<GraphData> m_pending_import {};
+
 	Edge* m_connecting_edge = nullptr;
 	bool m_connecting_cancel = false;
 
@@ -80,6 +176,110 @@ private:
 	Node* m_path_dst = nullptr;
 	bool m_pathfind_overlay_show = false;
 	Path m_path { Path::Empty() };
+	PathStrategy m_path_strategy = PathStrategy::BreadthFirst;
+
+	// Recent path searches, the latest first, to compare the strategies on the same nodes
+	struct PathQuery
+	{
+		std::string src;
+		std::string dst;
+		PathStrategy strategy;
+
+		bool reachable;
+		size_t length;
+		int weight;
+
+		SearchStats stats;
+	};
+
+	std::deque<PathQuery> m_path_history {};
+
+	// Shortest paths from the source while the destination is being chosen,
+	// previewed for the hovered node. Searched again once the snapshot it was
+	// built on is no longer current and a preview is wanted
+	std::optional<ShortestPathTree> m_path_tree {};
+	std::shared_ptr<const ObjectGraph> m_path_tree_graph {};
+	PathStrategy m_path_tree_strategy = PathStrategy::BreadthFirst;
+
+	Node* m_hovered_node = nullptr;
+	Node* m_preview_node = nullptr;
+	Path m_path_preview { Path::Empty() };
+
+	std::optional<MaxFlowResult> m_flow {};
+	std::vector<Edge*> m_cut_edges {};
+
+	struct NodeAnimation
+	{
+		Node* node;
+		sf::Vector2f from;
+		sf::Vector2f to;
+	};
+
+	size_t m_graph_version = 0;
+	size_t m_topology_version = 0;
+
+	std::shared_ptr<const ObjectGraph> m_graph {};
+	size_t m_graph_built_version = -1;
+
+	// The most the graph has changed since the snapshot was built
+	GraphChange m_graph_change = GraphChange::Nodes;
+
+	// Snapshots handed out so far, by the graph version they were built at
+	std::vector<std::pair<size_t, std::weak_ptr<const ObjectGraph>>> m_snapshots {};
+
+	// Objects removed from the graph, by the first graph version without them
+	struct RetiredObject
+	{
+		Object* object;
+		size_t epoch;
+	};
+
+	std::deque<RetiredObject> m_retired {};
+
+	Components m_components {};
+	size_t m_components_version = -1;
+
+	std::vector<NodeAnimation> m_animations {};
+	sf::Clock m_animation_clock {};
+
+	BackgroundTasks m_tasks {};
+
+	TileCache m_tile_cache {};
+	bool m_tiled_rendering = true;
+	bool m_tiles_active = false;
+
+	// Objects changed since the tiles were last drawn. The area they covered
+	// is invalidated right away, the area they cover now when drawing
+	std::unordered_set<Object*> m_changed_objects {};
+
+	// Set when the tiles are to be dropped, once too much has changed at once
+	bool m_tiles_stale = false;
+
+	void import(const GraphData& data);
+
+	// Searches for the path between the selected nodes with the selected strategy
+	void findPath();
+
+	// Adds the current path to the search history
+	void recordPath();
+
+	void findPathTree();
+	void updatePathPreview();
+	void resetPathPreview();
+
+	// Drops the maximum flow result and the indication of its cut edges
+	void resetMaxFlow();
+
+	void retire(Object* object);
+
+	// Has the area the object covered drawn again without it
+	void onObjectRemoved(Object* object);
+
+	// Frees the retired objects no snapshot can refer to anymore
+	void reclaim();
+
+	template<std::derived_from<Object> T>
+	void insertBatch(const std::vector<T*>& objects);
 
 };
 
@@ -89,8 +289,11 @@ template<std::derived_from<Object> T>
 T* ObjectManager::addObject(T* object)
 {
 	object->onAdded(this);
+	onObjectChanging(object);
 
 	m_objects.insert(object);
+	onGraphChanged(std::derived_from<T, Edge> ? GraphChange::Edges : GraphChange::Nodes);
+
 	return object;
 }
 
@@ -100,6 +303,43 @@ T* ObjectManager::operator+=(T* object)
 	return addObject(object);
 }
 
+template<std::derived_from<Object> T>
+void ObjectManager::insertBatch(const std::vector<T*>& objects)
+{
+	if (objects.empty())
+		return;
+
+	// Objects of a batch share the priority, inserting them at the end of their
+	// range with a hint costs amortized constant time instead of a tree descent
+	auto hint = m_objects.upper_bound(objects.front());
+	for (auto* object: objects)
+	{
+		object->onAdded(this);
+		hint = std::next(m_objects.insert(hint, object));
+	}
+
+	m_tiles_stale = true;
+	onGraphChanged(std::derived_from<T, Edge> ? GraphChange::Edges : GraphChange::Nodes);
+}
+
+template<typename Work, typename Apply>
+void ObjectManager::runGraphTask(std::string_view name, Work work, Apply apply)
+{
+	auto graph = getGraphSnapshot();
+
+	m_tasks.run(
+		name,
+		[graph, work = std::move(work)](TaskContext& context) mutable
+		{
+			return work(*graph, context);
+		},
+		[graph, apply = std::move(apply)](auto& result, float time) mutable
+		{
+			apply(*graph, result, time);
+		}
+	);
+}
+
 template<std::derived_from<Object> T>
 std::vector<T*> ObjectManager::findAll()
 {
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <Graph/TaskPool.hpp>
+
+//========================================
+
+// Number of worker threads used by the parallel algorithms
+inline size_t ThreadCount()
+{
+	return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+// Splits [0, count) into contiguous chunks, one per thread, and calls
+// body(begin, end, chunk_index) for each of them. The chunks are handed out
+// to the calling thread and to the idle workers of the default task pool,
+// so a loop never waits for a worker that is busy with something else.
+// Small ranges are processed on the calling thread
+template<typename F>
+void ParallelForRange(size_t count, F&& body, size_t grain = 1024)
+{
+	size_t threads = std::min(ThreadCount(), (count + grain - 1) / std::max<size_t>(grain, 1));
+	if (threads <= 1)
+	{
+		if (count)
+			body(size_t(0), count, size_t(0));
+
+		return;
+	}
+
+	size_t chunk = (count + threads - 1) / threads;
+
+	// Helpers that start after the loop has returned find no chunks left,
+	// and do not touch the body
+	struct Loop
+	{
+		std::atomic<size_t> next = 0;
+		std::atomic<size_t> done = 0;
+	};
+
+	auto loop = std::make_shared<Loop>();
+
+	auto work = [loop, &body, count, chunk, threads]
+	{
+		for (size_t i; (i = loop->next.fetch_add(1, std::memory_order_relaxed)) < threads; )
+		{
+			size_t begin = std::min(count, i * chunk);
+			body(begin, std::min(count, begin + chunk), i);
+
+			if (loop->done.fetch_add(1, std::memory_order_acq_rel) + 1 == threads)
+				loop->done.notify_all();
+		}
+	};
+
+	for (size_t i = 1; i < threads; i++)
+		TaskPool::Default().submit(work);
+
+	work();
+
+	for (size_t done; (done = loop->done.load(std::memory_order_acquire)) < threads; )
+		loop->done.wait(done, std::memory_order_acquire);
+}
+
+// Calls body(i) for every i in [0, count) in parallel
+template<typename F>
+void ParallelFor(size_t count, F&& body, size_t grain = 1024)
+{
+	ParallelForRange(
+		count,
+		[&body](size_t begin, size_t end, size_t)
+		{
+			for (size_t i = begin; i < end; i++)
+				body(i);
+		},
+		grain
+	);
+}
+
+//========================================
@@ -3,6 +3,9 @@
 #include <vector>
 
 #include <Graph/Objects/Node.hpp>
+#include <Graph/Objects/ObjectGraph.hpp>
+#include <Graph/Algorithms/Components.hpp>
+#include <Graph/Algorithms/ShortestPath.hpp>
 
 //========================================
 
@@ -20,17 +23,28 @@ public:
 	int getWeight() const;
 	std::string_view getString() const;
 
+	// Work done by the search that found the path
+	const SearchStats& getStats() const;
+
 	Node* getFirstNode() const;
 	Node* getLastNode() const;
 
 	bool contains(Node* node) const;
 	bool contains(Edge* edge) const;
 
+	// Empties the path, the edges the other path goes through stay indicated
+	void clear(const Path& keep);
+
 	bool empty() const;
+	bool unreachable() const;
 	operator bool() const;
 
 	static Path Empty();
-	static Path Shortest(Node* src, Node* dst);
+	static Path Unreachable();
+
+	// Objects along a path found in the graph snapshot, unreachable when the
+	// search found none. The snapshot must still match the objects
+	static Path FromCompact(const ObjectGraph& graph, const CompactPath& path);
 
 private:
 	Path() = default;
@@ -42,6 +56,8 @@ private:
 	std::string m_string {};
 	size_t m_length { 0 };
 	int m_weight { 0 };
+	bool m_unreachable { false };
+	SearchStats m_stats {};
 
 };
 
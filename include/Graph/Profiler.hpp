@@ -0,0 +1,104 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+//========================================
+
+// CPU timings of the nested phases of the last frames, shown as a flame chart
+// of one frame and a histogram of the frame times. Zones can also be recorded
+// for as long as wanted and saved as a Chrome trace (chrome://tracing, Perfetto)
+class Profiler
+{
+public:
+	Profiler();
+
+	void beginFrame();
+	void endFrame();
+
+	// Zones nest, the name must outlive the profiler (string literals, Object::getName)
+	void begin(const char* name);
+	void end();
+
+	void startTrace();
+	void stopTrace();
+	bool isTracing() const;
+
+	bool saveTrace(const std::filesystem::path& path) const;
+
+	// Profiler window, closed through the flag
+	void showWindow(bool* open);
+
+private:
+	using clock = std::chrono::steady_clock;
+
+	struct Zone
+	{
+		const char* name;
+		unsigned    depth;
+
+		// Milliseconds since the start of the frame
+		float start;
+		float duration;
+	};
+
+	struct Frame
+	{
+		clock::time_point start {};
+		float duration = 0;
+		std::vector<Zone> zones {};
+	};
+
+	struct TraceEvent
+	{
+		const char* name;
+
+		// Microseconds since the start of the trace
+		double start;
+		double duration;
+	};
+
+	// Ring of the recorded frames, m_next is the oldest once it is full
+	std::vector<Frame> m_frames {};
+	size_t m_frame_count = 0;
+	size_t m_next = 0;
+
+	Frame m_current {};
+	std::vector<size_t> m_open {};
+
+	bool m_paused = false;
+	int m_selected = 0;
+
+	bool m_tracing = false;
+	clock::time_point m_trace_start {};
+	std::vector<TraceEvent> m_trace {};
+
+	std::string m_trace_path {};
+	std::string m_trace_message {};
+
+	// Recorded frame by age, zero is the latest
+	const Frame& getFrame(size_t age) const;
+
+	void showFlameChart(const Frame& frame);
+	void showSummary();
+
+};
+
+//========================================
+
+// Times the enclosing scope, does nothing without a profiler
+class ProfileScope
+{
+public:
+	ProfileScope(Profiler* profiler, const char* name);
+	ProfileScope(const ProfileScope& copy) = delete;
+	~ProfileScope();
+
+private:
+	Profiler* m_profiler;
+
+};
+
+//========================================
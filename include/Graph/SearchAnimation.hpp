@@ -0,0 +1,93 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SFML/System.hpp>
+
+#include <Graph/Objects/ObjectManager.hpp>
+#include <Graph/Algorithms/SearchSteps.hpp>
+#include <Graph/Generator.hpp>
+
+//========================================
+
+// Runs a search on the UI thread a few steps per frame and colours its
+// frontier and visited nodes as it goes, with the tree of the arcs the
+// nodes were reached by shown as a path. The number of steps per frame
+// follows the chosen speed, but shrinks when the frame rate drops
+class SearchAnimation
+{
+public:
+	explicit SearchAnimation(ObjectManager& manager);
+	SearchAnimation(const SearchAnimation& copy) = delete;
+
+	// Opens the window, from the node the path search was started at if any
+	void show();
+
+	// Advances the search by the steps due this frame
+	void update();
+	void processInterface();
+
+	// Whether the search advances on its own and needs every frame drawn
+	bool isPlaying() const;
+
+private:
+	enum class Algorithm
+	{
+		BreadthFirst,
+		DepthFirst,
+		Dijkstra
+	};
+
+	enum class NodeState: uint8_t
+	{
+		Unseen,
+		Frontier,
+		Settled
+	};
+
+	ObjectManager& m_object_manager;
+
+	bool m_show = false;
+	int m_algorithm = static_cast<int>(Algorithm::BreadthFirst);
+	std::string m_source {};
+	std::string m_message {};
+
+	// The generator refers to the snapshot, and is destroyed first
+	std::shared_ptr<const ObjectGraph> m_graph {};
+	Generator<SearchStep> m_steps {};
+
+	std::vector<NodeState> m_states {};
+	std::vector<CompactGraph::index_t> m_tree_edges {};
+
+	bool m_paused = false;
+	bool m_single_step = false;
+
+	// Steps per second, and the milliseconds of a frame they may take
+	float m_speed;
+	float m_budget;
+
+	// Steps due but not made yet
+	double m_due = 0;
+	sf::Clock m_frame_clock {};
+
+	size_t m_step_count = 0;
+	size_t m_frontier = 0;
+	size_t m_settled = 0;
+	int64_t m_distance = 0;
+
+	void start();
+	void stop();
+
+	bool running() const;
+
+	// Makes the next step, returns false once the search has finished
+	bool advance();
+
+	// Puts back the colours and path indications the search has changed
+	void restore();
+
+};
+
+//========================================
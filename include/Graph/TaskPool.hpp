@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//========================================
+
+// Progress and cancellation shared between a long running task and its owner.
+// Algorithms that take one poll it between units of work and return early,
+// with an incomplete result, once it is cancelled
+class TaskContext
+{
+public:
+	void cancel();
+	bool isCancelled() const;
+
+	// Fraction of the work done, negative while it is unknown
+	void setProgress(double progress);
+	double getProgress() const;
+
+private:
+	std::atomic<bool>   m_cancelled = false;
+	std::atomic<double> m_progress  = -1;
+
+};
+
+//========================================
+
+// Work-stealing thread pool. Every worker keeps its own queue, takes the
+// newest task from it and steals the oldest ones from the other workers
+// once it runs dry. Tasks submitted from outside the pool go through a
+// shared queue
+class TaskPool
+{
+public:
+	using Task = std::move_only_function<void()>;
+
+	explicit TaskPool(size_t threads);
+	TaskPool(const TaskPool& copy) = delete;
+	~TaskPool();
+
+	// Pool shared by the parallel algorithms and the background tasks
+	static TaskPool& Default();
+
+	void submit(Task task);
+
+	size_t getThreadCount() const;
+
+private:
+	struct Worker
+	{
+		std::mutex mutex {};
+		std::deque<Task> tasks {};
+	};
+
+	std::vector<std::unique_ptr<Worker>> m_workers {};
+	std::vector<std::jthread> m_threads {};
+
+	std::mutex m_shared_mutex {};
+	std::deque<Task> m_shared_tasks {};
+
+	// Queued tasks, the idle workers sleep while there are none
+	std::mutex m_sleep_mutex {};
+	std::condition_variable m_wake {};
+	size_t m_queued = 0;
+	bool m_stop = false;
+
+	void run(size_t index);
+	bool take(size_t index, Task& task);
+
+};
+
+//========================================
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include <Graph/Objects/Object.hpp>
+
+//========================================
+
+// Objects rasterised into square textures that are drawn back instead of the
+// objects themselves. The tiles are laid out in the frame of the view, by its
+// scale and rotation, so that they land on the screen pixel for pixel. Panning
+// reuses them, and only the tiles under the objects that have changed are
+// drawn again, from the objects a spatial index finds around them, so a frame
+// costs the visible tiles and the changes rather than the objects
+class TileCache
+{
+public:
+	TileCache() = default;
+	TileCache(const TileCache& copy) = delete;
+
+	// Has the tiles under the area drawn again the next time they are visible
+	void invalidate(const sf::FloatRect& area);
+
+	// Moves the object to its current bounds in the index, or adds it there,
+	// and has the tiles under the bounds drawn again
+	void update(Object* object);
+
+	// Drops the object and has the tiles under it drawn again
+	void remove(Object* object);
+
+	// Drops the tiles and the index
+	void clear();
+
+	// Draws the objects to the target through the tiles covering its view,
+	// the missing and invalidated ones are drawn first. The objects are indexed
+	// anew on the first draw after a clear, and are to be kept up to date with
+	// update and remove from then on. Returns false and draws nothing if
+	// a tile could not be created
+	bool draw(sf::RenderTarget& target, const std::multiset<Object*, ObjectPtrCmp>& objects);
+
+private:
+	// Tiles of the same view scale and rotation are drawn together
+	struct Key
+	{
+		float scale;
+		float rotation;
+		int x;
+		int y;
+
+		auto operator<=>(const Key& key) const = default;
+	};
+
+	struct Tile
+	{
+		std::unique_ptr<sf::RenderTexture> texture {};
+
+		// The area the tile covers, widened by the antialiasing of the
+		// shapes around it, and the view it is drawn through
+		sf::FloatRect bounds {};
+		sf::View view {};
+
+		bool dirty = true;
+		size_t last_used = 0;
+	};
+
+	std::map<Key, Tile> m_tiles {};
+
+	// Loose grid over the world, so that drawing tiles again only visits the
+	// objects around them. The cells of every level are twice as large as those
+	// of the previous one. An object sits in the cell of its centre on the first
+	// level whose cells are at least as large as the object, so it reaches at
+	// most half a cell beyond that cell
+	static constexpr size_t index_levels = 24;
+
+	struct IndexItem
+	{
+		Object* object;
+
+		// Drawing order, by priority and then by the order the objects were added in
+		int priority;
+		uint64_t sequence;
+	};
+
+	struct IndexEntry
+	{
+		// Objects without bounds are kept in no cell
+		size_t level;
+		uint64_t cell;
+		size_t slot;
+
+		uint64_t sequence;
+	};
+
+	std::array<std::unordered_map<uint64_t, std::vector<IndexItem>>, index_levels> m_cells {};
+	std::unordered_map<Object*, IndexEntry> m_entries {};
+	uint64_t m_sequence = 0;
+	bool m_indexed = false;
+
+	// Textures of the evicted tiles, reused by the new ones
+	std::vector<std::unique_ptr<sf::RenderTexture>> m_spare_textures {};
+
+	size_t m_frame = 0;
+
+	std::unique_ptr<sf::RenderTexture> createTexture();
+
+	// Places the object in the cell of its current bounds, keeping its drawing order
+	void index(Object* object);
+	void unindex(const IndexEntry& entry);
+
+	// Objects in the cells that reach into any of the areas, in drawing order
+	std::vector<Object*> query(const std::vector<sf::FloatRect>& areas) const;
+
+	// Drops the least recently drawn tiles beyond the limit
+	void evict();
+
+};
+
+//========================================
@@ -8,4 +8,7 @@ sf::Color Interpolate(sf::Color a, sf::Color b, float t);
 sf::Color Invert(sf::Color color);
 sf::Color HSV(int h, int s, int v, int a = 0xFF);
 
+// Smallest rectangle containing both
+sf::FloatRect Union(const sf::FloatRect& a, const sf::FloatRect& b);
+
 //========================================
\ No newline at end of file
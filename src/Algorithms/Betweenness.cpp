@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+
+#include <Graph/Algorithms/Betweenness.hpp>
+#include <Graph/Parallel.hpp>
+
+//========================================
+
+namespace
+{
+
+using index_t = CompactGraph::index_t;
+
+constexpr auto unvisited = std::numeric_limits<index_t>::max();
+
+// Buffers of one thread. Only the entries of the nodes reached from a source
+// are reset after it, so a search costs the size of its component, not n
+struct BrandesState
+{
+	std::vector<index_t> distances;
+	std::vector<double>  paths;
+	std::vector<double>  dependencies;
+	std::vector<index_t> order;
+
+	std::vector<double> node_scores;
+	std::vector<double> edge_scores;
+
+	BrandesState(size_t nodes, size_t edges):
+		distances(nodes, unvisited),
+		paths(nodes, 0),
+		dependencies(nodes, 0),
+		node_scores(nodes, 0),
+		edge_scores(edges, 0)
+	{
+		order.reserve(nodes);
+	}
+
+	void run(const CompactGraph& graph, index_t src)
+	{
+		distances[src] = 0;
+		paths[src] = 1;
+		order.push_back(src);
+
+		// Breadth-first search counting the shortest paths, the order doubles as the queue
+		for (size_t head = 0; head < order.size(); head++)
+		{
+			index_t node = order[head];
+			for (auto arc: graph.getOutArcs(node))
+			{
+				if (distances[arc.node] == unvisited)
+				{
+					distances[arc.node] = distances[node] + 1;
+					order.push_back(arc.node);
+				}
+
+				if (distances[arc.node] == distances[node] + 1)
+					paths[arc.node] += paths[node];
+			}
+		}
+
+		// Dependencies accumulate from the farthest nodes back to the source
+		for (size_t i = order.size(); i-- > 0; )
+		{
+			index_t node = order[i];
+			for (auto arc: graph.getInArcs(node))
+			{
+				if (distances[arc.node] + 1 != distances[node])
+					continue;
+
+				double dependency = paths[arc.node] / paths[node] * (1 + dependencies[node]);
+
+				dependencies[arc.node] += dependency;
+				edge_scores[arc.edge]  += dependency;
+			}
+
+			if (node != src)
+				node_scores[node] += dependencies[node];
+		}
+
+		for (auto node: order)
+		{
+			distances[node]    = unvisited;
+			paths[node]        = 0;
+			dependencies[node] = 0;
+		}
+
+		order.clear();
+	}
+};
+
+} // namespace
+
+//========================================
+
+Betweenness BetweennessCentrality(const CompactGraph& graph, const BetweennessSettings& settings /*= {}*/)
+{
+	const size_t n = graph.getNodeCount();
+	const size_t m = graph.getEdgeCount();
+
+	std::vector<index_t> sources(n);
+	std::iota(sources.begin(), sources.end(), 0);
+
+	if (settings.samples && settings.samples < n)
+	{
+		std::mt19937_64 gen(settings.seed);
+		std::shuffle(sources.begin(), sources.end(), gen);
+		sources.resize(settings.samples);
+	}
+
+	// Searches differ a lot in cost, threads take sources one by one
+	std::atomic<size_t> next_source = 0;
+	std::atomic<size_t> searched = 0;
+	std::vector<std::unique_ptr<BrandesState>> states(std::min(ThreadCount(), sources.size()));
+
+	ParallelForRange(
+		states.size(),
+		[&](size_t begin, size_t end, size_t)
+		{
+			for (size_t thread = begin; thread < end; thread++)
+			{
+				states[thread] = std::make_unique<BrandesState>(n, m);
+
+				for (size_t i; (i = next_source.fetch_add(1, std::memory_order_relaxed)) < sources.size(); )
+				{
+					if (settings.context && settings.context->isCancelled())
+						break;
+
+					states[thread]->run(graph, sources[i]);
+
+					if (settings.context)
+						settings.context->setProgress(
+							static_cast<double>(searched.fetch_add(1, std::memory_order_relaxed) + 1) / sources.size()
+						);
+				}
+			}
+		},
+		1
+	);
+
+	Betweenness result;
+	result.sources = sources.size();
+	result.nodes.assign(n, 0);
+	result.edges.assign(m, 0);
+
+	// Every undirected path is found from both of its ends
+	double scale = sources.size()
+		? (graph.isDirected() ? 1. : .5) * n / sources.size()
+		: 0;
+
+	ParallelFor(
+		n,
+		[&](size_t node)
+		{
+			for (const auto& state: states)
+				result.nodes[node] += state->node_scores[node];
+
+			result.nodes[node] *= scale;
+		}
+	);
+
+	ParallelFor(
+		m,
+		[&](size_t edge)
+		{
+			for (const auto& state: states)
+				result.edges[edge] += state->edge_scores[edge];
+
+			result.edges[edge] *= scale;
+		}
+	);
+
+	return result;
+}
+
+//========================================
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <numeric>
+
+#include <Graph/Algorithms/BreadthFirstSearch.hpp>
+#include <Graph/Parallel.hpp>
+
+//========================================
+
+namespace
+{
+
+using index_t = CompactGraph::index_t;
+
+constexpr size_t word_bits = 64;
+
+size_t WordCount(size_t bits)
+{
+	return (bits + word_bits - 1) / word_bits;
+}
+
+bool TestBit(const std::vector<uint64_t>& bitmap, index_t bit)
+{
+	return bitmap[bit / word_bits] >> (bit % word_bits) & 1;
+}
+
+} // namespace
+
+//========================================
+
+bool BreadthFirstSearchResult::reached(CompactGraph::index_t node) const
+{
+	return distances[node] != unreachable;
+}
+
+size_t BreadthFirstSearchResult::getReachedCount() const
+{
+	return std::accumulate(level_sizes.begin(), level_sizes.end(), size_t(0));
+}
+
+//========================================
+
+BreadthFirstSearchResult BreadthFirstSearch(const CompactGraph& graph, CompactGraph::index_t src, const BreadthFirstSearchSettings& settings /*= {}*/)
+{
+	constexpr auto unreachable = BreadthFirstSearchResult::unreachable;
+
+	const size_t n = graph.getNodeCount();
+	const size_t threads = ThreadCount();
+
+	BreadthFirstSearchResult result;
+	result.distances.resize(n);
+	result.parents.resize(n);
+
+	ParallelFor(
+		n,
+		[&](size_t node)
+		{
+			result.distances[node] = unreachable;
+		}
+	);
+
+	auto& distances = result.distances;
+	auto& parents   = result.parents;
+
+	distances[src] = 0;
+	parents[src]   = { src, unreachable };
+
+	// Top-down steps work on a node queue, bottom-up steps on a bitmap
+	std::vector<index_t> frontier { src };
+	std::vector<uint64_t> frontier_bits, next_bits;
+
+	std::vector<std::vector<index_t>> local_frontiers(threads);
+	std::vector<size_t> local_arcs(threads);
+	std::vector<size_t> local_examined(threads, 0);
+
+	bool bottom_up = false;
+	size_t frontier_size = 1;
+	size_t frontier_arcs = graph.getOutArcs(src).size();
+
+	// Arcs of the nodes that are not reached yet
+	size_t unexplored_arcs = 2 * graph.getEdgeCount() - frontier_arcs;
+
+	for (index_t level = 0; frontier_size; level++)
+	{
+		result.level_sizes.push_back(frontier_size);
+
+		if (settings.target < n && distances[settings.target] != unreachable)
+			break;
+
+		// Direction switch
+		if (!bottom_up && frontier_arcs > unexplored_arcs / settings.alpha)
+		{
+			bottom_up = true;
+
+			frontier_bits.assign(WordCount(n), 0);
+			for (auto node: frontier)
+				frontier_bits[node / word_bits] |= uint64_t(1) << (node % word_bits);
+		}
+
+		else if (bottom_up && frontier_size < n / settings.beta)
+		{
+			bottom_up = false;
+
+			frontier.clear();
+			for (size_t word = 0; word < frontier_bits.size(); word++)
+				for (uint64_t bits = frontier_bits[word]; bits; bits &= bits - 1)
+					frontier.push_back(static_cast<index_t>(word * word_bits + std::countr_zero(bits)));
+		}
+
+		std::fill(local_arcs.begin(), local_arcs.end(), 0);
+		size_t next_size = 0;
+
+		if (bottom_up)
+		{
+			result.bottom_up_levels++;
+			next_bits.assign(frontier_bits.size(), 0);
+
+			// Every thread owns whole bitmap words, so it can write them without atomics
+			std::vector<size_t> local_sizes(threads);
+			ParallelForRange(
+				frontier_bits.size(),
+				[&](size_t begin, size_t end, size_t thread)
+				{
+					for (size_t word = begin; word < end; word++)
+					{
+						uint64_t bits = 0;
+
+						size_t last = std::min(n, (word + 1) * word_bits);
+						for (size_t node = word * word_bits; node < last; node++)
+						{
+							if (distances[node] != unreachable)
+								continue;
+
+							// Looks for a parent among the nodes with an arc into this one
+							for (auto arc: graph.getInArcs(static_cast<index_t>(node)))
+							{
+								local_examined[thread]++;
+								if (!TestBit(frontier_bits, arc.node))
+									continue;
+
+								distances[node] = level + 1;
+								parents[node]   = { arc.node, arc.edge };
+
+								bits |= uint64_t(1) << (node % word_bits);
+								local_arcs[thread] += graph.getOutArcs(static_cast<index_t>(node)).size();
+								local_sizes[thread]++;
+								break;
+							}
+						}
+
+						next_bits[word] = bits;
+					}
+				},
+				16
+			);
+
+			std::swap(frontier_bits, next_bits);
+			next_size = std::accumulate(local_sizes.begin(), local_sizes.end(), size_t(0));
+		}
+
+		else
+		{
+			ParallelForRange(
+				frontier.size(),
+				[&](size_t begin, size_t end, size_t thread)
+				{
+					auto& local = local_frontiers[thread];
+					local.clear();
+
+					for (size_t i = begin; i < end; i++)
+					{
+						index_t node = frontier[i];
+						local_examined[thread] += graph.getOutArcs(node).size();
+
+						for (auto arc: graph.getOutArcs(node))
+						{
+							// Claim the node, other threads may have found it in the same level
+							std::atomic_ref<index_t> distance(distances[arc.node]);
+
+							index_t expected = unreachable;
+							if (distance.load(std::memory_order_relaxed) != unreachable)
+								continue;
+
+							if (!distance.compare_exchange_strong(expected, level + 1, std::memory_order_relaxed))
+								continue;
+
+							parents[arc.node] = { node, arc.edge };
+							local.push_back(arc.node);
+							local_arcs[thread] += graph.getOutArcs(arc.node).size();
+						}
+					}
+				},
+				256
+			);
+
+			frontier.clear();
+			for (auto& local: local_frontiers)
+			{
+				frontier.insert(frontier.end(), local.begin(), local.end());
+				local.clear();
+			}
+
+			next_size = frontier.size();
+		}
+
+		frontier_size = next_size;
+		frontier_arcs = std::accumulate(local_arcs.begin(), local_arcs.end(), size_t(0));
+		unexplored_arcs -= std::min(unexplored_arcs, frontier_arcs);
+	}
+
+	result.examined_arcs = std::accumulate(local_examined.begin(), local_examined.end(), size_t(0));
+	return result;
+}
+
+//========================================
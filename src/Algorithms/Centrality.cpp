@@ -0,0 +1,364 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include <Graph/Algorithms/Centrality.hpp>
+#include <Graph/Parallel.hpp>
+
+//========================================
+
+namespace
+{
+
+using index_t = CompactGraph::index_t;
+
+// Transposed weighted adjacency matrix in CSR form with the values next to the
+// columns, so that the product streams through two flat arrays. Row i holds the
+// arcs into node i, which is the whole neighbourhood without directed edges
+class AdjacencyMatrix
+{
+public:
+	explicit AdjacencyMatrix(const CompactGraph& graph):
+		m_size(graph.getNodeCount()),
+		m_offsets(graph.getNodeCount() + 1, 0)
+	{
+		for (index_t node = 0; node < m_size; node++)
+			m_offsets[node + 1] = m_offsets[node] + graph.getInArcs(node).size();
+
+		m_columns.resize(m_offsets.back());
+		m_values.resize(m_offsets.back());
+
+		ParallelFor(
+			m_size,
+			[&](size_t node)
+			{
+				size_t i = m_offsets[node];
+				for (auto arc: graph.getInArcs(static_cast<index_t>(node)))
+				{
+					m_columns[i] = arc.node;
+					m_values[i]  = std::max(graph.getWeight(arc.edge), 0);
+					i++;
+				}
+			}
+		);
+
+		// Rows are split by the number of nonzeros, hubs would unbalance a split by rows
+		size_t threads = ThreadCount();
+		m_partition.resize(threads + 1);
+
+		for (size_t thread = 0; thread <= threads; thread++)
+		{
+			auto target = m_offsets.back() * thread / threads;
+			m_partition[thread] = std::lower_bound(m_offsets.begin(), m_offsets.end(), target) - m_offsets.begin();
+		}
+
+		m_partition.back() = m_size;
+	}
+
+	size_t size() const
+	{
+		return m_size;
+	}
+
+	// y = A * x, then y[i] = finish(i, y[i]) while the row is still in cache
+	template<typename F>
+	void multiply(const std::vector<double>& x, std::vector<double>& y, F&& finish) const
+	{
+		const size_t*  offsets = m_offsets.data();
+		const index_t* columns = m_columns.data();
+		const double*  values  = m_values.data();
+		const double*  input   = x.data();
+
+		ParallelForRange(
+			m_partition.size() - 1,
+			[&](size_t begin, size_t end, size_t)
+			{
+				for (size_t part = begin; part < end; part++)
+				{
+					for (size_t row = m_partition[part]; row < m_partition[part + 1]; row++)
+					{
+						// Four independent sums let the loop vectorize without reassociating
+						double sums[4] = {};
+
+						size_t i = offsets[row];
+						size_t last = offsets[row + 1];
+
+						for (; i + 4 <= last; i += 4)
+							for (size_t lane = 0; lane < 4; lane++)
+								sums[lane] += values[i + lane] * input[columns[i + lane]];
+
+						for (; i < last; i++)
+							sums[0] += values[i] * input[columns[i]];
+
+						y[row] = finish(row, (sums[0] + sums[1]) + (sums[2] + sums[3]));
+					}
+				}
+			},
+			1
+		);
+	}
+
+private:
+	size_t m_size;
+
+	std::vector<size_t>  m_offsets;
+	std::vector<index_t> m_columns;
+	std::vector<double>  m_values;
+
+	std::vector<size_t> m_partition;
+
+};
+
+// Total weight of the arcs leaving every node
+std::vector<double> OutStrengths(const CompactGraph& graph)
+{
+	std::vector<double> strengths(graph.getNodeCount(), 0);
+	ParallelFor(
+		strengths.size(),
+		[&](size_t node)
+		{
+			for (auto arc: graph.getOutArcs(static_cast<index_t>(node)))
+				strengths[node] += std::max(graph.getWeight(arc.edge), 0);
+		}
+	);
+
+	return strengths;
+}
+
+double ParallelSum(const std::vector<double>& values, auto&& term)
+{
+	std::vector<double> partial(ThreadCount(), 0);
+	ParallelForRange(
+		values.size(),
+		[&](size_t begin, size_t end, size_t thread)
+		{
+			double sum = 0;
+			for (size_t i = begin; i < end; i++)
+				sum += term(i);
+
+			partial[thread] = sum;
+		}
+	);
+
+	return std::accumulate(partial.begin(), partial.end(), 0.);
+}
+
+// Start vector of the iteration, scaled to the given L1 norm
+std::vector<double> StartVector(size_t size, std::span<const double> start, double norm)
+{
+	std::vector<double> x(size, 1);
+	if (start.size() == size)
+		x.assign(start.begin(), start.end());
+
+	double sum = 0;
+	for (auto& value: x)
+		sum += value = std::abs(value);
+
+	if (sum <= 0)
+	{
+		std::fill(x.begin(), x.end(), 1.);
+		sum = static_cast<double>(size);
+	}
+
+	for (auto& value: x)
+		value *= norm / sum;
+
+	return x;
+}
+
+// Runs step(x, y) until the L1 distance between consecutive vectors is small enough
+template<typename F>
+PowerIterationResult Iterate(std::vector<double> x, const PowerIterationSettings& settings, F&& step)
+{
+	PowerIterationResult result;
+	std::vector<double> y(x.size());
+
+	while (result.iterations < settings.max_iterations)
+	{
+		if (settings.context && settings.context->isCancelled())
+			break;
+
+		step(x, y);
+		result.iterations++;
+
+		if (settings.context)
+			settings.context->setProgress(static_cast<double>(result.iterations) / settings.max_iterations);
+
+		result.residual = ParallelSum(
+			x,
+			[&](size_t i)
+			{
+				return std::abs(y[i] - x[i]);
+			}
+		);
+
+		std::swap(x, y);
+
+		if (!std::isfinite(result.residual))
+			break;
+
+		if (result.residual < settings.tolerance)
+		{
+			result.converged = true;
+			break;
+		}
+	}
+
+	result.scores = std::move(x);
+	return result;
+}
+
+void Normalize(std::vector<double>& x)
+{
+	double norm = std::sqrt(
+		ParallelSum(
+			x,
+			[&](size_t i)
+			{
+				return x[i] * x[i];
+			}
+		)
+	);
+
+	if (norm > 0)
+		ParallelFor(
+			x.size(),
+			[&](size_t i)
+			{
+				x[i] /= norm;
+			}
+		);
+}
+
+} // namespace
+
+//========================================
+
+PowerIterationResult PageRank(const CompactGraph& graph, const PowerIterationSettings& settings /*= {}*/, std::span<const double> start /*= {}*/)
+{
+	const size_t n = graph.getNodeCount();
+	if (!n)
+		return {};
+
+	AdjacencyMatrix matrix(graph);
+	auto strengths = OutStrengths(graph);
+
+	// Walk probabilities are folded into the vector: the product runs on x / strength
+	std::vector<double> scaled(n);
+
+	return Iterate(
+		StartVector(n, start, 1),
+		settings,
+		[&](const std::vector<double>& x, std::vector<double>& y)
+		{
+			ParallelFor(
+				n,
+				[&](size_t i)
+				{
+					scaled[i] = strengths[i] > 0
+						? x[i] / strengths[i]
+						: 0;
+				}
+			);
+
+			// Nodes without edges jump to a random node
+			double dangling = ParallelSum(
+				x,
+				[&](size_t i)
+				{
+					return strengths[i] > 0
+						? 0
+						: x[i];
+				}
+			);
+
+			double teleport = (1 - settings.damping + settings.damping * dangling) / n;
+
+			matrix.multiply(
+				scaled,
+				y,
+				[&](size_t, double sum)
+				{
+					return teleport + settings.damping * sum;
+				}
+			);
+		}
+	);
+}
+
+PowerIterationResult KatzCentrality(const CompactGraph& graph, const PowerIterationSettings& settings /*= {}*/, std::span<const double> start /*= {}*/)
+{
+	const size_t n = graph.getNodeCount();
+	if (!n)
+		return {};
+
+	AdjacencyMatrix matrix(graph);
+
+	// The fixed point is not normalized, a normalized warm start is rescaled to the uniform sum
+	auto result = Iterate(
+		StartVector(n, start, settings.beta * n),
+		settings,
+		[&](const std::vector<double>& x, std::vector<double>& y)
+		{
+			matrix.multiply(
+				x,
+				y,
+				[&](size_t, double sum)
+				{
+					return settings.alpha * sum + settings.beta;
+				}
+			);
+		}
+	);
+
+	Normalize(result.scores);
+	return result;
+}
+
+PowerIterationResult EigenvectorCentrality(const CompactGraph& graph, const PowerIterationSettings& settings /*= {}*/, std::span<const double> start /*= {}*/)
+{
+	const size_t n = graph.getNodeCount();
+	if (!n)
+		return {};
+
+	AdjacencyMatrix matrix(graph);
+
+	// Iterates in the L1 norm, which keeps the residual comparable with the other methods
+	auto result = Iterate(
+		StartVector(n, start, 1),
+		settings,
+		[&](const std::vector<double>& x, std::vector<double>& y)
+		{
+			matrix.multiply(
+				x,
+				y,
+				[&](size_t row, double sum)
+				{
+					return sum + x[row];
+				}
+			);
+
+			double norm = ParallelSum(
+				y,
+				[&](size_t i)
+				{
+					return y[i];
+				}
+			);
+
+			if (norm > 0)
+				ParallelFor(
+					n,
+					[&](size_t i)
+					{
+						y[i] /= norm;
+					}
+				);
+		}
+	);
+
+	Normalize(result.scores);
+	return result;
+}
+
+//========================================
@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#include <Graph/Algorithms/Coloring.hpp>
+#include <Graph/Parallel.hpp>
+
+//========================================
+
+namespace
+{
+
+using index_t = CompactGraph::index_t;
+
+constexpr auto uncolored = std::numeric_limits<index_t>::max();
+
+// Degrees without the self loops
+std::vector<size_t> LoopFreeDegrees(const CompactGraph& graph)
+{
+	std::vector<size_t> degrees(graph.getNodeCount());
+	ParallelFor(
+		degrees.size(),
+		[&](size_t node)
+		{
+			for (auto arc: graph.getArcs(static_cast<index_t>(node)))
+				degrees[node] += arc.node != node;
+		}
+	);
+
+	return degrees;
+}
+
+// Nodes sorted by decreasing degree, ties by index
+std::vector<index_t> LargestFirstOrder(const std::vector<size_t>& degrees, size_t max_degree)
+{
+	std::vector<size_t> bins(max_degree + 2, 0);
+	for (auto degree: degrees)
+		bins[max_degree - degree + 1]++;
+
+	std::partial_sum(bins.begin(), bins.end(), bins.begin());
+
+	std::vector<index_t> order(degrees.size());
+	for (index_t node = 0; node < degrees.size(); node++)
+		order[bins[max_degree - degrees[node]]++] = node;
+
+	return order;
+}
+
+// Bucket queue peeling of the nodes of the smallest remaining degree
+// (Matula-Beck), the order is the reverse of the removal order
+std::vector<index_t> SmallestLastOrder(const CompactGraph& graph, std::vector<size_t> degrees, size_t max_degree)
+{
+	const size_t n = degrees.size();
+
+	// Nodes sorted by degree, with the start of every degree bin
+	std::vector<size_t> bins(max_degree + 1, 0);
+	for (auto degree: degrees)
+		bins[degree]++;
+
+	size_t start = 0;
+	for (auto& bin: bins)
+		start += std::exchange(bin, start);
+
+	std::vector<index_t> sorted(n);
+	std::vector<size_t> positions(n);
+
+	for (index_t node = 0; node < n; node++)
+	{
+		positions[node] = bins[degrees[node]]++;
+		sorted[positions[node]] = node;
+	}
+
+	for (size_t degree = max_degree; degree > 0; degree--)
+		bins[degree] = bins[degree - 1];
+
+	bins[0] = 0;
+
+	// Removing a node moves each of its remaining neighbours
+	// to the front of its bin, and the bin start past it
+	for (size_t i = 0; i < n; i++)
+	{
+		index_t node = sorted[i];
+		for (auto arc: graph.getArcs(node))
+		{
+			index_t neighbour = arc.node;
+			if (positions[neighbour] <= i || degrees[neighbour] <= degrees[node])
+				continue;
+
+			size_t degree = degrees[neighbour];
+			size_t front = std::max(bins[degree], i + 1);
+			index_t other = sorted[front];
+
+			if (other != neighbour)
+			{
+				std::swap(sorted[front], sorted[positions[neighbour]]);
+				std::swap(positions[other], positions[neighbour]);
+			}
+
+			bins[degree] = front + 1;
+			degrees[neighbour]--;
+		}
+	}
+
+	std::reverse(sorted.begin(), sorted.end());
+	return sorted;
+}
+
+} // namespace
+
+//========================================
+
+size_t Coloring::getCount() const
+{
+	return sizes.size();
+}
+
+//========================================
+
+Coloring GreedyColoring(const CompactGraph& graph, ColoringOrder order /*= ColoringOrder::SmallestLast*/)
+{
+	const size_t n = graph.getNodeCount();
+
+	auto degrees = LoopFreeDegrees(graph);
+	size_t max_degree = n
+		? *std::max_element(degrees.begin(), degrees.end())
+		: 0;
+
+	std::vector<index_t> worklist;
+	switch (order)
+	{
+		case ColoringOrder::Natural:
+			worklist.resize(n);
+			std::iota(worklist.begin(), worklist.end(), 0);
+			break;
+
+		case ColoringOrder::LargestFirst:
+			worklist = LargestFirstOrder(degrees, max_degree);
+			break;
+
+		case ColoringOrder::SmallestLast:
+			worklist = SmallestLastOrder(graph, degrees, max_degree);
+			break;
+	}
+
+	std::vector<index_t> ranks(n);
+	for (index_t i = 0; i < n; i++)
+		ranks[worklist[i]] = i;
+
+	Coloring result;
+	result.colors.assign(n, uncolored);
+
+	// Colours used by the neighbours of the current node, marked with its index
+	// and the round, so that the marks of an earlier round of the node do not count.
+	// A node has at most max_degree coloured neighbours, so one more colour always fits
+	std::vector<std::vector<size_t>> forbidden(ThreadCount());
+	std::vector<std::vector<index_t>> conflicts(ThreadCount());
+
+	// The worklist is coloured in consecutive batches, each one finished before
+	// the next, so the colouring sweeps through it close to the order. The first
+	// nodes of the degree orders are the densely connected ones, the batches
+	// start small and grow as the conflicts get rare
+	const size_t max_batch_grain = 1024;
+	size_t batch_grain = 8;
+
+	std::vector<index_t> pending;
+
+	for (size_t batch = 0, batch_size; batch < n; batch += batch_size)
+	{
+		batch_size = batch_grain * ThreadCount();
+		batch_grain = std::min(batch_grain * 2, max_batch_grain);
+
+		pending.assign(worklist.begin() + batch, worklist.begin() + std::min(n, batch + batch_size));
+		size_t grain = std::max<size_t>(1, pending.size() / ThreadCount());
+
+		for (size_t round = 1; !pending.empty(); round++)
+		{
+			result.rounds = std::max(result.rounds, round);
+
+			ParallelForRange(
+				pending.size(),
+				[&](size_t begin, size_t end, size_t thread)
+				{
+					auto& marks = forbidden[thread];
+					if (marks.empty())
+						marks.assign(max_degree + 1, std::numeric_limits<size_t>::max());
+
+					for (size_t i = begin; i < end; i++)
+					{
+						index_t node = pending[i];
+						size_t stamp = round * n + node;
+
+						for (auto arc: graph.getArcs(node))
+						{
+							auto color = std::atomic_ref(result.colors[arc.node]).load(std::memory_order_relaxed);
+							if (arc.node != node && color < marks.size())
+								marks[color] = stamp;
+						}
+
+						index_t color = 0;
+						while (color < marks.size() && marks[color] == stamp)
+							color++;
+
+						std::atomic_ref(result.colors[node]).store(color, std::memory_order_relaxed);
+					}
+				},
+				grain
+			);
+
+			// Of two adjacent nodes with the same colour, the later one in the order gives it up
+			ParallelForRange(
+				pending.size(),
+				[&](size_t begin, size_t end, size_t thread)
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						index_t node = pending[i];
+						for (auto arc: graph.getArcs(node))
+						{
+							if (arc.node != node && result.colors[arc.node] == result.colors[node] && ranks[arc.node] < ranks[node])
+							{
+								conflicts[thread].push_back(node);
+								break;
+							}
+						}
+					}
+				},
+				grain
+			);
+
+			// Chunks are contiguous, joining them in thread order keeps the nodes ordered
+			pending.clear();
+			for (auto& part: conflicts)
+			{
+				pending.insert(pending.end(), part.begin(), part.end());
+				part.clear();
+			}
+
+			for (auto node: pending)
+				result.colors[node] = uncolored;
+
+			result.conflicts += pending.size();
+		}
+	}
+
+	for (auto color: result.colors)
+	{
+		if (color >= result.sizes.size())
+			result.sizes.resize(color + 1, 0);
+
+		result.sizes[color]++;
+	}
+
+	return result;
+}
+
+//========================================
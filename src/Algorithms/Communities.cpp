@@ -0,0 +1,436 @@
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <numeric>
+
+#include <Graph/Algorithms/Communities.hpp>
+#include <Graph/Parallel.hpp>
+
+//========================================
+
+namespace
+{
+
+using index_t = CompactGraph::index_t;
+
+constexpr auto unassigned = std::numeric_limits<index_t>::max();
+
+// Weighted symmetric adjacency matrix of one level. A self loop is a single
+// arc carrying both ends of the edge, so the degrees sum up to twice the
+// total weight on every level
+struct LevelGraph
+{
+	std::vector<size_t>  offsets {};
+	std::vector<index_t> targets {};
+	std::vector<double>  weights {};
+	std::vector<double>  degrees {};
+
+	size_t size() const
+	{
+		return degrees.size();
+	}
+};
+
+// Weights from one node to the surrounding communities. The arrays span all
+// communities, only the touched entries are reset, and they are reused on every level
+struct NeighbourWeights
+{
+	std::vector<double>  weights {};
+	std::vector<uint8_t> seen    {};
+	std::vector<index_t> touched {};
+
+	void resize(size_t count)
+	{
+		weights.assign(count, 0);
+		seen.assign(count, 0);
+	}
+
+	void add(index_t community, double weight)
+	{
+		if (!seen[community])
+		{
+			seen[community] = 1;
+			touched.push_back(community);
+		}
+
+		weights[community] += weight;
+	}
+
+	void clear()
+	{
+		for (auto community: touched)
+		{
+			weights[community] = 0;
+			seen[community] = 0;
+		}
+
+		touched.clear();
+	}
+};
+
+void BuildFirstLevel(const CompactGraph& graph, LevelGraph& level)
+{
+	const size_t n = graph.getNodeCount();
+
+	level.offsets.resize(n + 1);
+	level.offsets[0] = 0;
+	for (index_t node = 0; node < n; node++)
+		level.offsets[node + 1] = level.offsets[node] + graph.getDegree(node);
+
+	level.targets.resize(level.offsets.back());
+	level.weights.resize(level.offsets.back());
+	level.degrees.resize(n);
+
+	ParallelFor(
+		n,
+		[&](size_t node)
+		{
+			size_t i = level.offsets[node];
+			double degree = 0;
+
+			for (auto arc: graph.getArcs(static_cast<index_t>(node)))
+			{
+				double weight = std::max(graph.getWeight(arc.edge), 0);
+				if (arc.node == node)
+					weight *= 2;
+
+				level.targets[i] = arc.node;
+				level.weights[i] = weight;
+				degree += weight;
+				i++;
+			}
+
+			level.degrees[node] = degree;
+		}
+	);
+}
+
+class LouvainLevels
+{
+public:
+	LouvainLevels(const LouvainSettings& settings, size_t node_count):
+		m_settings(settings),
+		m_scratch(ThreadCount())
+	{
+		for (auto& scratch: m_scratch)
+			scratch.resize(node_count);
+	}
+
+	// Moves the nodes of the level between communities until the moves dry up,
+	// returns the number of sweeps
+	int moveNodes(const LevelGraph& level, std::vector<index_t>& communities, double total_weight)
+	{
+		const size_t n = level.size();
+
+		communities.resize(n);
+		std::iota(communities.begin(), communities.end(), 0);
+		m_totals.assign(level.degrees.begin(), level.degrees.end());
+
+		const double scale = m_settings.resolution / total_weight;
+		std::vector<size_t> moved(m_scratch.size());
+
+		int pass = 0;
+		while (pass < m_settings.max_passes)
+		{
+			if (m_settings.context && m_settings.context->isCancelled())
+				break;
+
+			pass++;
+			std::fill(moved.begin(), moved.end(), 0);
+
+			ParallelForRange(
+				n,
+				[&](size_t begin, size_t end, size_t thread)
+				{
+					auto& scratch = m_scratch[thread];
+
+					for (size_t node = begin; node < end; node++)
+					{
+						std::atomic_ref community(communities[node]);
+						index_t current = community.load(std::memory_order_relaxed);
+						double degree = level.degrees[node];
+
+						for (size_t i = level.offsets[node]; i < level.offsets[node + 1]; i++)
+						{
+							if (level.targets[i] == node)
+								continue;
+
+							auto neighbour = std::atomic_ref(communities[level.targets[i]]).load(std::memory_order_relaxed);
+							scratch.add(neighbour, level.weights[i]);
+						}
+
+						// Gain of joining a community, relative to leaving the current one
+						auto gain = [&](index_t target)
+						{
+							double total = std::atomic_ref(m_totals[target]).load(std::memory_order_relaxed);
+							if (target == current)
+								total -= degree;
+
+							return scratch.weights[target] - scale * degree * total;
+						};
+
+						index_t best = current;
+						double best_gain = gain(current);
+
+						for (auto target: scratch.touched)
+						{
+							double target_gain = gain(target);
+							if (target_gain > best_gain || (target_gain == best_gain && target < best))
+							{
+								best = target;
+								best_gain = target_gain;
+							}
+						}
+
+						scratch.clear();
+
+						if (best != current)
+						{
+							std::atomic_ref(m_totals[current]).fetch_sub(degree, std::memory_order_relaxed);
+							std::atomic_ref(m_totals[best]).fetch_add(degree, std::memory_order_relaxed);
+							community.store(best, std::memory_order_relaxed);
+							moved[thread]++;
+						}
+					}
+				},
+				256
+			);
+
+			if (std::accumulate(moved.begin(), moved.end(), size_t(0)) <= m_settings.min_moved * n)
+				break;
+		}
+
+		return pass;
+	}
+
+	// Modularity of the partition of the level
+	double getModularity(const LevelGraph& level, const std::vector<index_t>& communities, double total_weight) const
+	{
+		const size_t n = level.size();
+
+		std::vector<double> internal(n, 0);
+		std::vector<double> totals(n, 0);
+
+		for (size_t node = 0; node < n; node++)
+		{
+			totals[communities[node]] += level.degrees[node];
+			for (size_t i = level.offsets[node]; i < level.offsets[node + 1]; i++)
+				if (communities[level.targets[i]] == communities[node])
+					internal[communities[node]] += level.weights[i];
+		}
+
+		double modularity = 0;
+		for (size_t community = 0; community < n; community++)
+			modularity += internal[community] - m_settings.resolution * totals[community] * totals[community] / total_weight;
+
+		return modularity / total_weight;
+	}
+
+	// Renumbers the communities densely and merges each of them into one node
+	// of the coarse level, returns the number of communities
+	size_t coarsen(const LevelGraph& level, std::vector<index_t>& communities, LevelGraph& coarse)
+	{
+		const size_t n = level.size();
+
+		m_dense.assign(n, unassigned);
+		for (auto community: communities)
+			m_dense[community] = 0;
+
+		size_t count = 0;
+		for (auto& id: m_dense)
+			if (id != unassigned)
+				id = static_cast<index_t>(count++);
+
+		for (auto& community: communities)
+			community = m_dense[community];
+
+		// Nodes grouped by community
+		m_member_offsets.assign(count + 1, 0);
+		for (auto community: communities)
+			m_member_offsets[community + 1]++;
+
+		std::partial_sum(m_member_offsets.begin(), m_member_offsets.end(), m_member_offsets.begin());
+
+		m_members.resize(n);
+		m_heads.assign(m_member_offsets.begin(), m_member_offsets.end() - 1);
+		for (index_t node = 0; node < n; node++)
+			m_members[m_heads[communities[node]]++] = node;
+
+		// Every thread merges a contiguous range of communities into its own
+		// buffers, which are then copied into place in thread order
+		m_buffers.resize(m_scratch.size());
+		for (auto& buffer: m_buffers)
+		{
+			buffer.targets.clear();
+			buffer.weights.clear();
+		}
+
+		coarse.offsets.assign(count + 1, 0);
+		coarse.degrees.assign(count, 0);
+
+		ParallelForRange(
+			count,
+			[&](size_t begin, size_t end, size_t thread)
+			{
+				auto& scratch = m_scratch[thread];
+				auto& buffer = m_buffers[thread];
+
+				buffer.begin = begin;
+
+				for (size_t community = begin; community < end; community++)
+				{
+					for (size_t m = m_member_offsets[community]; m < m_member_offsets[community + 1]; m++)
+					{
+						index_t node = m_members[m];
+						coarse.degrees[community] += level.degrees[node];
+
+						for (size_t i = level.offsets[node]; i < level.offsets[node + 1]; i++)
+							scratch.add(communities[level.targets[i]], level.weights[i]);
+					}
+
+					for (auto target: scratch.touched)
+					{
+						buffer.targets.push_back(target);
+						buffer.weights.push_back(scratch.weights[target]);
+					}
+
+					coarse.offsets[community + 1] = scratch.touched.size();
+					scratch.clear();
+				}
+			},
+			256
+		);
+
+		std::partial_sum(coarse.offsets.begin(), coarse.offsets.end(), coarse.offsets.begin());
+		coarse.targets.resize(coarse.offsets.back());
+		coarse.weights.resize(coarse.offsets.back());
+
+		ParallelForRange(
+			m_buffers.size(),
+			[&](size_t begin, size_t end, size_t)
+			{
+				for (size_t thread = begin; thread < end; thread++)
+				{
+					const auto& buffer = m_buffers[thread];
+					if (buffer.targets.empty())
+						continue;
+
+					size_t offset = coarse.offsets[buffer.begin];
+					std::ranges::copy(buffer.targets, coarse.targets.begin() + offset);
+					std::ranges::copy(buffer.weights, coarse.weights.begin() + offset);
+				}
+			},
+			1
+		);
+
+		return count;
+	}
+
+private:
+	struct ArcBuffer
+	{
+		size_t begin = 0;
+		std::vector<index_t> targets {};
+		std::vector<double>  weights {};
+	};
+
+	const LouvainSettings& m_settings;
+
+	std::vector<NeighbourWeights> m_scratch;
+	std::vector<ArcBuffer> m_buffers {};
+	std::vector<double> m_totals {};
+
+	std::vector<index_t> m_dense {};
+	std::vector<size_t>  m_member_offsets {};
+	std::vector<size_t>  m_heads {};
+	std::vector<index_t> m_members {};
+
+};
+
+} // namespace
+
+//========================================
+
+size_t Communities::getCount() const
+{
+	return sizes.size();
+}
+
+//========================================
+
+Communities LouvainCommunities(const CompactGraph& graph, const LouvainSettings& settings /*= {}*/)
+{
+	const size_t n = graph.getNodeCount();
+
+	LevelGraph level;
+	LevelGraph coarse;
+	BuildFirstLevel(graph, level);
+
+	const double total_weight = std::accumulate(level.degrees.begin(), level.degrees.end(), 0.);
+
+	// Coarse node of every node of the graph
+	std::vector<index_t> mapping(n);
+	std::iota(mapping.begin(), mapping.end(), 0);
+
+	Communities result;
+
+	if (total_weight > 0)
+	{
+		LouvainLevels levels(settings, n);
+		std::vector<index_t> communities;
+
+		double modularity = levels.getModularity(level, mapping, total_weight);
+
+		for (int i = 0; i < settings.max_levels; i++)
+		{
+			if (settings.context && settings.context->isCancelled())
+				break;
+
+			int passes = levels.moveNodes(level, communities, total_weight);
+			double level_modularity = levels.getModularity(level, communities, total_weight);
+
+			if (level_modularity - modularity < settings.min_gain)
+				break;
+
+			size_t count = levels.coarsen(level, communities, coarse);
+			ParallelFor(
+				n,
+				[&](size_t node)
+				{
+					mapping[node] = communities[mapping[node]];
+				}
+			);
+
+			result.levels.push_back({ count, level_modularity, passes });
+			modularity = level_modularity;
+
+			if (count == level.size())
+				break;
+
+			std::swap(level, coarse);
+		}
+
+		result.modularity = modularity;
+	}
+
+	// Renumber in the order of the smallest node
+	std::vector<index_t> labels(n, unassigned);
+	result.labels.resize(n);
+
+	for (index_t node = 0; node < n; node++)
+	{
+		auto& label = labels[mapping[node]];
+		if (label == unassigned)
+		{
+			label = static_cast<index_t>(result.sizes.size());
+			result.sizes.push_back(0);
+		}
+
+		result.labels[node] = label;
+		result.sizes[label]++;
+	}
+
+	return result;
+}
+
+//========================================
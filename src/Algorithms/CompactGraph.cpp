@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+#include <Graph/Algorithms/CompactGraph.hpp>
+
+//========================================
+
+CompactGraph::CompactGraph()
+{
+	// Every empty graph shares the same arcs
+	static const auto empty = std::make_shared<const Adjacency>();
+	m_adjacency = empty;
+}
+
+CompactGraph::CompactGraph(size_t node_count, std::span<const EdgeRecord> edges):
+	m_node_count(node_count),
+	m_edges(edges.begin(), edges.end())
+{
+	auto adjacency = std::make_shared<Adjacency>();
+	auto& offsets = adjacency->offsets;
+	auto& arcs    = adjacency->arcs;
+
+	offsets.assign(node_count + 1, 0);
+	for (const auto& edge: m_edges)
+	{
+		assert(edge.a < node_count && edge.b < node_count);
+
+		offsets[edge.a + 1]++;
+		if (edge.a != edge.b)
+			offsets[edge.b + 1]++;
+	}
+
+	std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+	arcs.resize(offsets.back());
+
+	std::vector<size_t> heads(offsets.begin(), offsets.end() - 1);
+	for (index_t i = 0; i < m_edges.size(); i++)
+	{
+		const auto& edge = m_edges[i];
+
+		arcs[heads[edge.a]++] = { edge.b, i };
+		if (edge.a != edge.b)
+			arcs[heads[edge.b]++] = { edge.a, i };
+	}
+
+	m_directed = std::ranges::any_of(m_edges, &EdgeRecord::directed);
+	if (m_directed)
+	{
+		filterArcs(*adjacency, true,  adjacency->out_offsets, adjacency->out_arcs);
+		filterArcs(*adjacency, false, adjacency->in_offsets,  adjacency->in_arcs);
+	}
+
+	m_adjacency = std::move(adjacency);
+}
+
+void CompactGraph::filterArcs(const Adjacency& adjacency, bool outgoing, std::vector<size_t>& offsets, std::vector<Arc>& arcs) const
+{
+	offsets.assign(m_node_count + 1, 0);
+	arcs.clear();
+	arcs.reserve(adjacency.arcs.size());
+
+	for (index_t node = 0; node < m_node_count; node++)
+	{
+		for (size_t i = adjacency.offsets[node]; i < adjacency.offsets[node + 1]; i++)
+		{
+			auto arc = adjacency.arcs[i];
+
+			const auto& edge = m_edges[arc.edge];
+			if (!edge.directed || (outgoing ? edge.a : edge.b) == node)
+				arcs.push_back(arc);
+		}
+
+		offsets[node + 1] = arcs.size();
+	}
+}
+
+//========================================
+
+size_t CompactGraph::getNodeCount() const
+{
+	return m_node_count;
+}
+
+size_t CompactGraph::getEdgeCount() const
+{
+	return m_edges.size();
+}
+
+size_t CompactGraph::getDegree(index_t node) const
+{
+	return m_adjacency->offsets[node + 1] - m_adjacency->offsets[node];
+}
+
+std::span<const CompactGraph::Arc> CompactGraph::getArcs(index_t node) const
+{
+	const auto& offsets = m_adjacency->offsets;
+	return std::span(m_adjacency->arcs).subspan(offsets[node], offsets[node + 1] - offsets[node]);
+}
+
+std::span<const CompactGraph::Arc> CompactGraph::getOutArcs(index_t node) const
+{
+	if (!m_directed)
+		return getArcs(node);
+
+	const auto& offsets = m_adjacency->out_offsets;
+	return std::span(m_adjacency->out_arcs).subspan(offsets[node], offsets[node + 1] - offsets[node]);
+}
+
+std::span<const CompactGraph::Arc> CompactGraph::getInArcs(index_t node) const
+{
+	if (!m_directed)
+		return getArcs(node);
+
+	const auto& offsets = m_adjacency->in_offsets;
+	return std::span(m_adjacency->in_arcs).subspan(offsets[node], offsets[node + 1] - offsets[node]);
+}
+
+bool CompactGraph::isDirected() const
+{
+	return m_directed;
+}
+
+const CompactGraph::EdgeRecord& CompactGraph::getEdge(index_t edge) const
+{
+	return m_edges[edge];
+}
+
+int CompactGraph::getWeight(index_t edge) const
+{
+	return m_edges[edge].weight;
+}
+
+bool CompactGraph::empty() const
+{
+	return m_node_count == 0;
+}
+
+CompactGraph CompactGraph::reweighted(std::span<const int> weights) const
+{
+	assert(weights.size() == m_edges.size());
+
+	CompactGraph graph(*this);
+	for (size_t i = 0; i < weights.size(); i++)
+		graph.m_edges[i].weight = weights[i];
+
+	return graph;
+}
+
+//========================================
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <limits>
+
+#include <Graph/Algorithms/Components.hpp>
+#include <Graph/Algorithms/UnionFind.hpp>
+#include <Graph/Parallel.hpp>
+
+//========================================
+
+size_t Components::getCount() const
+{
+	return sizes.size();
+}
+
+bool Components::connected(CompactGraph::index_t a, CompactGraph::index_t b) const
+{
+	return labels[a] == labels[b];
+}
+
+//========================================
+
+Components ConnectedComponents(const CompactGraph& graph)
+{
+	using index_t = CompactGraph::index_t;
+
+	size_t n = graph.getNodeCount();
+
+	ConcurrentUnionFind sets(n);
+	ParallelFor(
+		graph.getEdgeCount(),
+		[&](size_t i)
+		{
+			const auto& edge = graph.getEdge(static_cast<index_t>(i));
+			sets.unite(edge.a, edge.b);
+		}
+	);
+
+	// Every root is the smallest node of its component
+	std::vector<index_t> roots(n);
+	ParallelFor(
+		n,
+		[&](size_t node)
+		{
+			roots[node] = sets.find(static_cast<index_t>(node));
+		}
+	);
+
+	Components components;
+	components.labels.resize(n);
+
+	constexpr auto unassigned = std::numeric_limits<index_t>::max();
+	std::vector<index_t> root_labels(n, unassigned);
+
+	for (index_t node = 0; node < n; node++)
+	{
+		if (roots[node] == node)
+		{
+			root_labels[node] = static_cast<index_t>(components.sizes.size());
+			components.sizes.push_back(0);
+		}
+	}
+
+	for (index_t node = 0; node < n; node++)
+	{
+		components.labels[node] = root_labels[roots[node]];
+		components.sizes[components.labels[node]]++;
+	}
+
+	return components;
+}
+
+//========================================
+
+Components StronglyConnectedComponents(const CompactGraph& graph)
+{
+	using index_t = CompactGraph::index_t;
+
+	constexpr auto unvisited = std::numeric_limits<index_t>::max();
+
+	size_t n = graph.getNodeCount();
+
+	Components components;
+	components.labels.assign(n, unvisited);
+
+	// Visit order and the lowest visit order reachable through the search subtree
+	std::vector<index_t> order(n, unvisited);
+	std::vector<index_t> lowlinks(n);
+	index_t visited = 0;
+
+	// Visited nodes without a component yet, which are exactly the ones on Tarjan's stack
+	std::vector<index_t> stack;
+
+	// Search path, with the position of the next arc to follow from every node
+	struct Frame
+	{
+		index_t node;
+		size_t  arc;
+	};
+
+	std::vector<Frame> path;
+
+	auto visit = [&](index_t node)
+	{
+		order[node] = lowlinks[node] = visited++;
+		stack.push_back(node);
+		path.push_back({ node, 0 });
+	};
+
+	for (index_t root = 0; root < n; root++)
+	{
+		if (order[root] != unvisited)
+			continue;
+
+		visit(root);
+		while (!path.empty())
+		{
+			auto& frame = path.back();
+			index_t node = frame.node;
+			auto arcs = graph.getOutArcs(node);
+
+			if (frame.arc < arcs.size())
+			{
+				index_t next = arcs[frame.arc++].node;
+
+				if (order[next] == unvisited)
+					visit(next);
+
+				else if (components.labels[next] == unvisited)
+					lowlinks[node] = std::min(lowlinks[node], order[next]);
+
+				continue;
+			}
+
+			path.pop_back();
+			if (!path.empty())
+			{
+				index_t parent = path.back().node;
+				lowlinks[parent] = std::min(lowlinks[parent], lowlinks[node]);
+			}
+
+			if (lowlinks[node] != order[node])
+				continue;
+
+			// The node is the root of a component, which is on the stack above it
+			auto label = static_cast<index_t>(components.sizes.size());
+			size_t size = 0;
+
+			index_t member;
+			do
+			{
+				member = stack.back();
+				stack.pop_back();
+
+				components.labels[member] = label;
+				size++;
+			}
+			while (member != node);
+
+			components.sizes.push_back(size);
+		}
+	}
+
+	return components;
+}
+
+//========================================
@@ -0,0 +1,551 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <unordered_set>
+
+#include <Graph/Algorithms/Generators.hpp>
+#include <Graph/Parallel.hpp>
+
+//========================================
+
+namespace
+{
+
+using EdgeRecord = CompactGraph::EdgeRecord;
+using index_t    = CompactGraph::index_t;
+
+// Work is split into a fixed number of chunks with their own random streams,
+// so the output does not depend on the number of threads
+constexpr size_t chunk_count = 256;
+
+uint64_t SplitMix64(uint64_t x)
+{
+	x += 0x9e3779b97f4a7c15;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+	return x ^ (x >> 31);
+}
+
+std::mt19937_64 ChunkGenerator(uint64_t seed, size_t chunk)
+{
+	return std::mt19937_64(SplitMix64(seed ^ SplitMix64(chunk + 1)));
+}
+
+// Concatenates per chunk edge lists in chunk order
+std::vector<EdgeRecord> Concatenate(std::vector<std::vector<EdgeRecord>>& parts)
+{
+	std::vector<size_t> offsets(parts.size() + 1, 0);
+	for (size_t i = 0; i < parts.size(); i++)
+		offsets[i + 1] = offsets[i] + parts[i].size();
+
+	std::vector<EdgeRecord> edges(offsets.back());
+	ParallelFor(
+		parts.size(),
+		[&](size_t i)
+		{
+			std::copy(parts[i].begin(), parts[i].end(), edges.begin() + offsets[i]);
+			parts[i] = {};
+		},
+		1
+	);
+
+	return edges;
+}
+
+// Orders endpoints of every edge, drops self loops and duplicate edges
+void Simplify(std::vector<EdgeRecord>& edges, size_t nodes)
+{
+	if (edges.empty())
+		return;
+
+	// Bucket the edges by their first endpoint and sort the buckets in parallel
+	const size_t bucket_count = std::min(nodes, ThreadCount() * 8);
+	auto bucket_of = [&](const EdgeRecord& edge) -> size_t
+	{
+		return static_cast<size_t>(edge.a) * bucket_count / nodes;
+	};
+
+	std::vector<size_t> offsets(bucket_count + 1, 0);
+	for (auto& edge: edges)
+	{
+		if (edge.a > edge.b)
+			std::swap(edge.a, edge.b);
+
+		offsets[bucket_of(edge) + 1]++;
+	}
+
+	for (size_t i = 0; i < bucket_count; i++)
+		offsets[i + 1] += offsets[i];
+
+	std::vector<EdgeRecord> sorted(edges.size());
+	std::vector<size_t> heads(offsets.begin(), offsets.end() - 1);
+
+	for (const auto& edge: edges)
+		sorted[heads[bucket_of(edge)]++] = edge;
+
+	std::vector<size_t> sizes(bucket_count, 0);
+	ParallelFor(
+		bucket_count,
+		[&](size_t bucket)
+		{
+			auto begin = sorted.begin() + offsets[bucket];
+			auto end   = sorted.begin() + offsets[bucket + 1];
+
+			std::sort(
+				begin,
+				end,
+				[](const EdgeRecord& x, const EdgeRecord& y)
+				{
+					return x.a != y.a
+						? x.a < y.a
+						: x.b < y.b;
+				}
+			);
+
+			auto last = std::unique(
+				begin,
+				end,
+				[](const EdgeRecord& x, const EdgeRecord& y)
+				{
+					return x.a == y.a && x.b == y.b;
+				}
+			);
+
+			last = std::remove_if(
+				begin,
+				last,
+				[](const EdgeRecord& edge)
+				{
+					return edge.a == edge.b;
+				}
+			);
+
+			sizes[bucket] = last - begin;
+		},
+		1
+	);
+
+	edges.clear();
+	for (size_t bucket = 0; bucket < bucket_count; bucket++)
+		edges.insert(
+			edges.end(),
+			sorted.begin() + offsets[bucket],
+			sorted.begin() + offsets[bucket] + sizes[bucket]
+		);
+}
+
+uint64_t PairCount(uint64_t nodes)
+{
+	return nodes * (nodes - 1) / 2;
+}
+
+// Maps an index in [0, n(n-1)/2) to the pair (v, w) with w < v
+EdgeRecord PairAt(uint64_t index)
+{
+	auto v = static_cast<uint64_t>((1 + std::sqrt(1 + 8. * index)) / 2);
+	while (PairCount(v) > index)
+		v--;
+
+	while (PairCount(v + 1) <= index)
+		v++;
+
+	return { static_cast<index_t>(v), static_cast<index_t>(index - PairCount(v)), 1 };
+}
+
+} // namespace
+
+//========================================
+
+std::vector<EdgeRecord> GenerateGnp(size_t nodes, double probability, uint64_t seed)
+{
+	if (nodes < 2 || probability <= 0)
+		return {};
+
+	probability = std::min(probability, 1.);
+	const uint64_t pairs = PairCount(nodes);
+
+	// Row v holds the pairs (v, w) with w < v. Rows are split so that every chunk covers a similar number of pairs
+	std::vector<uint64_t> rows(chunk_count + 1);
+	for (size_t i = 0; i <= chunk_count; i++)
+	{
+		auto target = static_cast<double>(pairs) * i / chunk_count;
+		rows[i] = std::min<uint64_t>(nodes, static_cast<uint64_t>((1 + std::sqrt(1 + 8 * target)) / 2));
+	}
+
+	rows.front() = 1;
+	rows.back()  = nodes;
+
+	std::vector<std::vector<EdgeRecord>> parts(chunk_count);
+	ParallelFor(
+		chunk_count,
+		[&](size_t chunk)
+		{
+			auto gen = ChunkGenerator(seed, chunk);
+			std::uniform_real_distribution<double> uniform(0, 1);
+
+			auto& part = parts[chunk];
+			part.reserve(static_cast<size_t>(probability * (PairCount(rows[chunk + 1]) - PairCount(rows[chunk]))));
+
+			const double log_q = std::log1p(-probability);
+
+			int64_t v = rows[chunk];
+			int64_t w = -1;
+
+			const auto end = static_cast<int64_t>(rows[chunk + 1]);
+			while (v < end)
+			{
+				// Length of the run of pairs without an edge is geometrically distributed
+				if (probability < 1)
+				{
+					double skip = std::floor(std::log(1 - uniform(gen)) / log_q);
+					w += 1 + static_cast<int64_t>(std::min(skip, static_cast<double>(pairs)));
+				}
+
+				else
+					w++;
+
+				while (w >= v && v < end)
+				{
+					w -= v;
+					v++;
+				}
+
+				if (v < end)
+					part.push_back({ static_cast<index_t>(v), static_cast<index_t>(w), 1 });
+			}
+		},
+		1
+	);
+
+	return Concatenate(parts);
+}
+
+std::vector<EdgeRecord> GenerateGnm(size_t nodes, size_t edges, uint64_t seed)
+{
+	if (nodes < 2)
+		return {};
+
+	const uint64_t pairs = PairCount(nodes);
+	edges = std::min<uint64_t>(edges, pairs);
+
+	// Choosing more than a half of all pairs is cheaper done by choosing the ones to skip
+	bool complement = edges > pairs / 2;
+	uint64_t chosen = complement
+		? pairs - edges
+		: edges;
+
+	// Split the pair index space into chunks and distribute the number of chosen pairs between them
+	std::vector<uint64_t> begins(chunk_count + 1), counts(chunk_count);
+	for (size_t i = 0; i <= chunk_count; i++)
+		begins[i] = pairs * i / chunk_count;
+
+	auto gen = ChunkGenerator(seed, chunk_count);
+	uint64_t remaining_pairs = pairs, remaining_chosen = chosen;
+
+	for (size_t i = 0; i < chunk_count; i++)
+	{
+		uint64_t size = begins[i + 1] - begins[i];
+		uint64_t count = remaining_pairs
+			? std::binomial_distribution<uint64_t>(remaining_chosen, static_cast<double>(size) / remaining_pairs)(gen)
+			: 0;
+
+		// Keep the split feasible for the following chunks
+		uint64_t lower = remaining_chosen > remaining_pairs - size
+			? remaining_chosen - (remaining_pairs - size)
+			: 0;
+
+		counts[i] = std::clamp(count, lower, std::min(size, remaining_chosen));
+
+		remaining_pairs  -= size;
+		remaining_chosen -= counts[i];
+	}
+
+	std::vector<std::vector<EdgeRecord>> parts(chunk_count);
+	ParallelFor(
+		chunk_count,
+		[&](size_t chunk)
+		{
+			auto gen = ChunkGenerator(seed, chunk);
+			uint64_t size = begins[chunk + 1] - begins[chunk];
+
+			// Floyd's algorithm for sampling distinct values
+			std::unordered_set<uint64_t> sample;
+			sample.reserve(counts[chunk]);
+
+			for (uint64_t j = size - counts[chunk]; j < size; j++)
+			{
+				uint64_t t = std::uniform_int_distribution<uint64_t>(0, j)(gen);
+				if (!sample.insert(t).second)
+					sample.insert(j);
+			}
+
+			std::vector<uint64_t> indices(sample.begin(), sample.end());
+			std::sort(indices.begin(), indices.end());
+
+			auto& part = parts[chunk];
+			if (complement)
+			{
+				part.reserve(size - counts[chunk]);
+
+				size_t next = 0;
+				for (uint64_t j = 0; j < size; j++)
+				{
+					if (next < indices.size() && indices[next] == j)
+						next++;
+
+					else
+						part.push_back(PairAt(begins[chunk] + j));
+				}
+			}
+
+			else
+			{
+				part.reserve(indices.size());
+				for (auto j: indices)
+					part.push_back(PairAt(begins[chunk] + j));
+			}
+		},
+		1
+	);
+
+	return Concatenate(parts);
+}
+
+std::vector<EdgeRecord> GenerateBarabasiAlbert(size_t nodes, size_t attachment, uint64_t seed)
+{
+	if (nodes < 2 || attachment == 0)
+		return {};
+
+	attachment = std::min(attachment, nodes - 1);
+
+	std::mt19937_64 gen(SplitMix64(seed));
+
+	std::vector<EdgeRecord> edges;
+	edges.reserve(PairCount(attachment + 1) + (nodes - attachment - 1) * attachment);
+
+	// Every node appears in this list once per incident edge, so a uniform
+	// pick from it is a pick proportional to the degree
+	std::vector<index_t> endpoints;
+	endpoints.reserve(2 * edges.capacity());
+
+	// Seed with a clique of attachment + 1 nodes
+	for (index_t v = 0; v <= attachment; v++)
+	{
+		for (index_t w = 0; w < v; w++)
+		{
+			edges.push_back({ v, w, 1 });
+			endpoints.push_back(v);
+			endpoints.push_back(w);
+		}
+	}
+
+	std::vector<index_t> targets;
+	for (index_t v = static_cast<index_t>(attachment + 1); v < nodes; v++)
+	{
+		targets.clear();
+		while (targets.size() < attachment)
+		{
+			index_t target = endpoints[std::uniform_int_distribution<size_t>(0, endpoints.size() - 1)(gen)];
+			if (std::find(targets.begin(), targets.end(), target) == targets.end())
+				targets.push_back(target);
+		}
+
+		for (auto target: targets)
+		{
+			edges.push_back({ v, target, 1 });
+			endpoints.push_back(v);
+			endpoints.push_back(target);
+		}
+	}
+
+	return edges;
+}
+
+std::vector<EdgeRecord> GenerateWattsStrogatz(size_t nodes, size_t neighbours, double rewiring, uint64_t seed)
+{
+	if (nodes < 2)
+		return {};
+
+	const size_t half = std::max<size_t>(1, std::min(neighbours, nodes - 1) / 2);
+
+	// The lattice has no duplicates, half stays below nodes / 2 from three nodes on
+	std::vector<EdgeRecord> edges;
+	edges.reserve(nodes * half);
+
+	for (size_t u = 0; u < nodes; u++)
+		for (size_t j = 1; j <= half; j++)
+			edges.push_back({ static_cast<index_t>(u), static_cast<index_t>((u + j) % nodes), 1 });
+
+	// Rewiring keeps the edge count, so a new end must not be adjacent to u
+	// already. Every choice depends on the ones before it, which makes this
+	// pass sequential
+	auto key = [nodes](index_t u, index_t v) -> uint64_t
+	{
+		return static_cast<uint64_t>(std::min(u, v)) * nodes + std::max(u, v);
+	};
+
+	std::unordered_set<uint64_t> present;
+	present.reserve(edges.size());
+	for (const auto& edge: edges)
+		present.insert(key(edge.a, edge.b));
+
+	std::vector<size_t> degrees(nodes, 2 * half);
+
+	auto gen = ChunkGenerator(seed, 0);
+	std::uniform_real_distribution<double> uniform(0, 1);
+	std::uniform_int_distribution<index_t> random_node(0, static_cast<index_t>(nodes - 1));
+
+	for (auto& edge: edges)
+	{
+		if (uniform(gen) >= rewiring || degrees[edge.a] >= nodes - 1)
+			continue;
+
+		index_t v;
+		do v = random_node(gen); while (v == edge.a || present.contains(key(edge.a, v)));
+
+		present.erase(key(edge.a, edge.b));
+		present.insert(key(edge.a, v));
+
+		degrees[edge.b]--;
+		degrees[v]++;
+
+		edge.b = v;
+	}
+
+	Simplify(edges, nodes);
+
+	return edges;
+}
+
+std::vector<EdgeRecord> GenerateRMat(unsigned scale, size_t edge_factor, double a, double b, double c, uint64_t seed)
+{
+	if (scale < rmat_min_scale || scale > rmat_max_scale)
+		return {};
+
+	const uint64_t nodes = uint64_t(1) << scale;
+	const uint64_t total = edge_factor * nodes;
+	const uint64_t mask  = nodes - 1;
+
+	// Bijective scramble of the node indices, so that high degree nodes are not clustered at low indices
+	const uint64_t multiplier = SplitMix64(seed) | 1;
+	const uint64_t offset     = SplitMix64(seed + 1);
+
+	auto scramble = [&](uint64_t x) -> index_t
+	{
+		x = (x * multiplier + offset) & mask;
+		x ^= x >> (scale / 2 + 1);
+		x = (x * multiplier) & mask;
+		return static_cast<index_t>(x);
+	};
+
+	std::vector<std::vector<EdgeRecord>> parts(chunk_count);
+	ParallelFor(
+		chunk_count,
+		[&](size_t chunk)
+		{
+			auto gen = ChunkGenerator(seed, chunk);
+			std::uniform_real_distribution<double> uniform(0, 1);
+
+			uint64_t count = total * (chunk + 1) / chunk_count - total * chunk / chunk_count;
+
+			auto& part = parts[chunk];
+			part.reserve(count);
+
+			for (uint64_t i = 0; i < count; i++)
+			{
+				uint64_t u = 0, v = 0;
+				for (unsigned level = 0; level < scale; level++)
+				{
+					uint64_t bit = uint64_t(1) << (scale - 1 - level);
+					double r = uniform(gen);
+
+					if (r < a)
+						continue;
+
+					if (r < a + b)
+						v |= bit;
+
+					else if (r < a + b + c)
+						u |= bit;
+
+					else
+					{
+						u |= bit;
+						v |= bit;
+					}
+				}
+
+				part.push_back({ scramble(u), scramble(v), 1 });
+			}
+		},
+		1
+	);
+
+	auto edges = Concatenate(parts);
+	Simplify(edges, nodes);
+
+	return edges;
+}
+
+//========================================
+
+size_t RandomGraphSettings::getNodeCount() const
+{
+	if (model != RandomGraphModel::RMat)
+		return nodes;
+
+	// No nodes where the generator makes no edges
+	return scale >= rmat_min_scale && scale <= rmat_max_scale
+		? size_t(1) << scale
+		: 0;
+}
+
+bool RandomGraphSettings::isValid() const
+{
+	// Node indices must fit the graph, R-MAT derives its node count from the scale
+	if (model != RandomGraphModel::RMat && nodes > std::numeric_limits<index_t>::max())
+		return false;
+
+	switch (model)
+	{
+		case RandomGraphModel::Gnp:
+			return probability >= 0 && probability <= 1;
+
+		case RandomGraphModel::WattsStrogatz:
+			return rewiring >= 0 && rewiring <= 1;
+
+		case RandomGraphModel::RMat:
+			return
+				scale >= rmat_min_scale && scale <= rmat_max_scale &&
+				a >= 0 && b >= 0 && c >= 0 && a + b + c <= 1;
+
+		default:
+			return true;
+	}
+}
+
+std::vector<EdgeRecord> GenerateRandomGraph(const RandomGraphSettings& settings)
+{
+	switch (settings.model)
+	{
+		case RandomGraphModel::Gnp:
+			return GenerateGnp(settings.nodes, settings.probability, settings.seed);
+
+		case RandomGraphModel::Gnm:
+			return GenerateGnm(settings.nodes, settings.edges, settings.seed);
+
+		case RandomGraphModel::BarabasiAlbert:
+			return GenerateBarabasiAlbert(settings.nodes, settings.attachment, settings.seed);
+
+		case RandomGraphModel::WattsStrogatz:
+			return GenerateWattsStrogatz(settings.nodes, settings.neighbours, settings.rewiring, settings.seed);
+
+		case RandomGraphModel::RMat:
+			return GenerateRMat(settings.scale, settings.edge_factor, settings.a, settings.b, settings.c, settings.seed);
+	}
+
+	return {};
+}
+
+//========================================
@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#include <Graph/Algorithms/HyperBall.hpp>
+#include <Graph/Parallel.hpp>
+
+//========================================
+
+namespace
+{
+
+using index_t = CompactGraph::index_t;
+
+constexpr unsigned log2_registers_min = 4;
+constexpr unsigned log2_registers_max = 12;
+
+uint64_t SplitMix64(uint64_t x)
+{
+	x += 0x9e3779b97f4a7c15;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+	return x ^ (x >> 31);
+}
+
+// HyperLogLog counters of all nodes in one flat array, a counter per row
+class CounterArray
+{
+public:
+	CounterArray(size_t count, unsigned log2_registers):
+		m_log2_registers(log2_registers),
+		m_registers(size_t(1) << log2_registers),
+		m_data(count << log2_registers, 0)
+	{
+		// Bias correction constant from the HyperLogLog paper
+		double alpha =
+			m_registers == 16 ? .673 :
+			m_registers == 32 ? .697 :
+			m_registers == 64 ? .709 :
+			.7213 / (1 + 1.079 / m_registers);
+
+		m_alpha_mm = alpha * m_registers * m_registers;
+
+		for (size_t rank = 0; rank < m_inverse_powers.size(); rank++)
+			m_inverse_powers[rank] = std::ldexp(1., -static_cast<int>(rank));
+	}
+
+	uint8_t* operator[](size_t counter)
+	{
+		return m_data.data() + (counter << m_log2_registers);
+	}
+
+	const uint8_t* operator[](size_t counter) const
+	{
+		return m_data.data() + (counter << m_log2_registers);
+	}
+
+	size_t getRegisterCount() const
+	{
+		return m_registers;
+	}
+
+	void add(size_t counter, uint64_t hash)
+	{
+		// Leading bits choose the register, the rest give the rank. The guard bit
+		// caps the rank for hashes whose remaining bits are all zero
+		size_t reg = hash >> (64 - m_log2_registers);
+		uint64_t rest = (hash << m_log2_registers) | (uint64_t(1) << (m_log2_registers - 1));
+
+		auto rank = static_cast<uint8_t>(std::countl_zero(rest) + 1);
+		(*this)[counter][reg] = std::max((*this)[counter][reg], rank);
+	}
+
+	double estimate(size_t counter) const
+	{
+		const uint8_t* registers = (*this)[counter];
+
+		double sum = 0;
+		size_t zeros = 0;
+		for (size_t i = 0; i < m_registers; i++)
+		{
+			sum += m_inverse_powers[registers[i]];
+			zeros += registers[i] == 0;
+		}
+
+		double estimate = m_alpha_mm / sum;
+
+		// Linear counting is more precise for the small cardinalities
+		if (estimate <= 2.5 * m_registers && zeros)
+			estimate = m_registers * std::log(static_cast<double>(m_registers) / zeros);
+
+		return estimate;
+	}
+
+	void swap(CounterArray& other)
+	{
+		m_data.swap(other.m_data);
+	}
+
+private:
+	unsigned m_log2_registers;
+	size_t   m_registers;
+	double   m_alpha_mm;
+
+	std::array<double, 65> m_inverse_powers {};
+	std::vector<uint8_t>   m_data;
+
+};
+
+// Register-wise maximum. Counters have a multiple of 16 registers, blocks
+// of that fixed size compile to single vector instructions without a tail
+void Merge(uint8_t* __restrict dst, const uint8_t* __restrict src, size_t count)
+{
+	constexpr size_t block = 1 << log2_registers_min;
+
+	for (size_t i = 0; i < count; i += block)
+		for (size_t j = i; j < i + block; j++)
+			dst[j] = std::max(dst[j], src[j]);
+}
+
+} // namespace
+
+//========================================
+
+double HyperBallResult::getEffectiveDiameter(double fraction /*= .9*/) const
+{
+	if (neighbourhood.empty())
+		return 0;
+
+	double target = fraction * neighbourhood.back();
+	for (size_t t = 0; t < neighbourhood.size(); t++)
+	{
+		if (neighbourhood[t] < target)
+			continue;
+
+		if (t == 0)
+			return 0;
+
+		double prev = neighbourhood[t - 1];
+		return t - 1 + (target - prev) / (neighbourhood[t] - prev);
+	}
+
+	return static_cast<double>(neighbourhood.size() - 1);
+}
+
+//========================================
+
+HyperBallResult HyperBall(const CompactGraph& graph, const HyperBallSettings& settings /*= {}*/)
+{
+	const size_t n = graph.getNodeCount();
+	const unsigned log2_registers = std::clamp(settings.log2_registers, log2_registers_min, log2_registers_max);
+
+	CounterArray current(n, log2_registers);
+	CounterArray next(n, log2_registers);
+	const size_t registers = current.getRegisterCount();
+
+	std::vector<double> estimates(n);
+	std::vector<uint8_t> changed(n, 1);
+	std::vector<uint8_t> next_changed(n, 0);
+
+	HyperBallResult result;
+	result.closeness.assign(n, 0);
+	result.harmonic.assign(n, 0);
+
+	const size_t threads = ThreadCount();
+	std::vector<double> partial_sums(threads);
+
+	const uint64_t salt = SplitMix64(settings.seed);
+	ParallelForRange(
+		n,
+		[&](size_t begin, size_t end, size_t thread)
+		{
+			double sum = 0;
+			for (size_t node = begin; node < end; node++)
+			{
+				current.add(node, SplitMix64(node ^ salt));
+				estimates[node] = current.estimate(node);
+				sum += estimates[node];
+			}
+
+			partial_sums[thread] = sum;
+		}
+	);
+
+	// Distance sums are kept in the closeness until the end
+	auto& distances = result.closeness;
+	std::vector<double> initial = estimates;
+
+	result.neighbourhood.push_back(std::accumulate(partial_sums.begin(), partial_sums.end(), 0.));
+
+	for (size_t t = 1; n && (!settings.max_iterations || t <= settings.max_iterations); t++)
+	{
+		// The number of iterations is the unknown diameter, unless it is limited
+		if (settings.context && settings.context->isCancelled())
+			break;
+
+		if (settings.context && settings.max_iterations)
+			settings.context->setProgress(static_cast<double>(t - 1) / settings.max_iterations);
+
+		std::fill(partial_sums.begin(), partial_sums.end(), 0);
+		std::vector<uint8_t> any_changed(threads, 0);
+
+		ParallelForRange(
+			n,
+			[&](size_t begin, size_t end, size_t thread)
+			{
+				double sum = 0;
+				bool thread_changed = false;
+
+				for (size_t node = begin; node < end; node++)
+				{
+					uint8_t* counter = next[node];
+					std::memcpy(counter, current[node], registers);
+
+					for (auto arc: graph.getOutArcs(static_cast<index_t>(node)))
+						if (changed[arc.node])
+							Merge(counter, current[arc.node], registers);
+
+					next_changed[node] = std::memcmp(counter, current[node], registers) != 0;
+					if (next_changed[node])
+					{
+						// Raw estimates are monotone, the switch to linear counting may not be
+						double estimate = std::max(estimates[node], next.estimate(node));
+						double found = estimate - estimates[node];
+
+						distances[node] += found * t;
+						result.harmonic[node] += found / t;
+
+						estimates[node] = estimate;
+						thread_changed = true;
+					}
+
+					sum += estimates[node];
+				}
+
+				partial_sums[thread] = sum;
+				any_changed[thread] = thread_changed;
+			}
+		);
+
+		current.swap(next);
+		changed.swap(next_changed);
+
+		if (std::ranges::find(any_changed, 1) == any_changed.end())
+		{
+			result.converged = true;
+			break;
+		}
+
+		result.iterations = t;
+		result.neighbourhood.push_back(std::accumulate(partial_sums.begin(), partial_sums.end(), 0.));
+	}
+
+	ParallelFor(
+		n,
+		[&](size_t node)
+		{
+			double reached = estimates[node] - initial[node];
+			distances[node] = distances[node] > 0
+				? reached / distances[node]
+				: 0;
+		}
+	);
+
+	return result;
+}
+
+//========================================
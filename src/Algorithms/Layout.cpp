@@ -0,0 +1,1028 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <optional>
+
+#include <Graph/Algorithms/Layout.hpp>
+#include <Graph/Algorithms/Components.hpp>
+#include <Graph/Parallel.hpp>
+
+//========================================
+
+namespace
+{
+
+constexpr uint32_t unmatched = std::numeric_limits<uint32_t>::max();
+
+// Level of the multilevel hierarchy. Edges are stored in both directions,
+// weights hold the number of fine edges merged into a coarse one and mass
+// holds the number of fine nodes merged into a coarse node
+struct LayoutLevel
+{
+	std::vector<size_t>   offsets {};
+	std::vector<uint32_t> targets {};
+	std::vector<float>    weights {};
+	std::vector<float>    mass    {};
+
+	// Index of the node in the next coarser level
+	std::vector<uint32_t> parent  {};
+
+	size_t size() const
+	{
+		return mass.size();
+	}
+};
+
+//========================================
+
+uint32_t Hash(uint32_t x)
+{
+	x ^= x >> 16;
+	x *= 0x7feb352d;
+	x ^= x >> 15;
+	x *= 0x846ca68b;
+	x ^= x >> 16;
+	return x;
+}
+
+// Deterministic pseudo random value in [-1, 1)
+float Jitter(uint32_t seed, uint32_t index)
+{
+	return static_cast<float>(Hash(seed ^ Hash(index))) / (1ull << 31) - 1.f;
+}
+
+//========================================
+
+// Builds the finest level from the graph. Edge weights of the graph are
+// used when weighted is set, every edge counts as one otherwise. Weights
+// below one are raised to it, as the Laplacian must stay positive semidefinite
+LayoutLevel MakeFinestLevel(const CompactGraph& graph, bool weighted)
+{
+	size_t n = graph.getNodeCount();
+
+	LayoutLevel level;
+	level.offsets.resize(n + 1, 0);
+	level.mass.assign(n, 1.f);
+
+	for (CompactGraph::index_t u = 0; u < n; u++)
+	{
+		size_t degree = 0;
+		for (auto [v, edge]: graph.getArcs(u))
+			degree += v != u;
+
+		level.offsets[u + 1] = level.offsets[u] + degree;
+	}
+
+	level.targets.resize(level.offsets.back());
+	level.weights.resize(level.offsets.back());
+
+	ParallelFor(
+		n,
+		[&](size_t u)
+		{
+			size_t head = level.offsets[u];
+			for (auto [v, edge]: graph.getArcs(u))
+			{
+				if (v == u)
+					continue;
+
+				level.targets[head] = v;
+				level.weights[head] = weighted
+					? static_cast<float>(std::max(graph.getWeight(edge), 1))
+					: 1.f;
+
+				head++;
+			}
+		}
+	);
+
+	return level;
+}
+
+// Builds the next coarser level and fills fine.parent. Returns nothing
+// when the graph does not shrink enough to be worth another level
+std::optional<LayoutLevel> Coarsen(LayoutLevel& fine, const MultilevelLayoutSettings& settings, uint32_t seed)
+{
+	constexpr int matching_rounds = 4;
+
+	size_t n = fine.size();
+
+	std::vector<uint32_t> match(n, unmatched);
+	std::vector<uint32_t> proposal(n, unmatched);
+
+	// Handshake heavy edge matching: every free node proposes to its heaviest
+	// free neighbour, mutual proposals are matched
+	for (int round = 0; round < matching_rounds; round++)
+	{
+		ParallelFor(
+			n,
+			[&](size_t u)
+			{
+				proposal[u] = unmatched;
+				if (match[u] != unmatched)
+					return;
+
+				float best_score = 0;
+				uint32_t best_tie = 0;
+
+				for (size_t i = fine.offsets[u]; i < fine.offsets[u + 1]; i++)
+				{
+					uint32_t v = fine.targets[i];
+					if (match[v] != unmatched)
+						continue;
+
+					// Prefer heavy edges between light nodes, which keeps the coarse masses balanced
+					float score = fine.weights[i] / (fine.mass[u] + fine.mass[v]);
+					uint32_t tie = Hash(seed ^ Hash(v));
+
+					if (score > best_score || (score == best_score && tie > best_tie))
+					{
+						best_score = score;
+						best_tie = tie;
+						proposal[u] = v;
+					}
+				}
+			}
+		);
+
+		ParallelFor(
+			n,
+			[&](size_t u)
+			{
+				uint32_t v = proposal[u];
+				if (v != unmatched && proposal[v] == u)
+					match[u] = v;
+			}
+		);
+	}
+
+	fine.parent.assign(n, unmatched);
+
+	uint32_t coarse_count = 0;
+	for (uint32_t u = 0; u < n; u++)
+		if (match[u] != unmatched && u < match[u])
+			fine.parent[u] = fine.parent[match[u]] = coarse_count++;
+
+	// Star collapse: unmatched nodes join their heaviest matched neighbour
+	ParallelFor(
+		n,
+		[&](size_t u)
+		{
+			if (match[u] != unmatched)
+				return;
+
+			float best_weight = 0;
+			for (size_t i = fine.offsets[u]; i < fine.offsets[u + 1]; i++)
+			{
+				uint32_t v = fine.targets[i];
+				if (match[v] != unmatched && fine.weights[i] > best_weight)
+				{
+					best_weight = fine.weights[i];
+					fine.parent[u] = fine.parent[v];
+				}
+			}
+		}
+	);
+
+	for (uint32_t u = 0; u < n; u++)
+		if (fine.parent[u] == unmatched)
+			fine.parent[u] = coarse_count++;
+
+	if (coarse_count > settings.min_shrink * n)
+		return std::nullopt;
+
+	LayoutLevel coarse;
+	coarse.mass.assign(coarse_count, 0.f);
+	for (uint32_t u = 0; u < n; u++)
+		coarse.mass[fine.parent[u]] += fine.mass[u];
+
+	// Gather coarse arcs row by row
+	std::vector<size_t> counts(coarse_count + 1, 0);
+	for (uint32_t u = 0; u < n; u++)
+		for (size_t i = fine.offsets[u]; i < fine.offsets[u + 1]; i++)
+			if (fine.parent[u] != fine.parent[fine.targets[i]])
+				counts[fine.parent[u] + 1]++;
+
+	std::partial_sum(counts.begin(), counts.end(), counts.begin());
+
+	std::vector<std::pair<uint32_t, float>> arcs(counts.back());
+	std::vector<size_t> heads(counts.begin(), counts.end() - 1);
+
+	for (uint32_t u = 0; u < n; u++)
+	{
+		uint32_t cu = fine.parent[u];
+		for (size_t i = fine.offsets[u]; i < fine.offsets[u + 1]; i++)
+		{
+			uint32_t cv = fine.parent[fine.targets[i]];
+			if (cu != cv)
+				arcs[heads[cu]++] = { cv, fine.weights[i] };
+		}
+	}
+
+	// Merge parallel coarse arcs
+	std::vector<size_t> unique(coarse_count + 1, 0);
+	ParallelFor(
+		coarse_count,
+		[&](size_t cu)
+		{
+			auto begin = arcs.begin() + counts[cu];
+			auto end   = arcs.begin() + counts[cu + 1];
+			std::sort(begin, end, [](const auto& a, const auto& b) { return a.first < b.first; });
+
+			auto out = begin;
+			for (auto it = begin; it != end; it++)
+			{
+				if (out != begin && (out - 1)->first == it->first)
+					(out - 1)->second += it->second;
+
+				else
+					*out++ = *it;
+			}
+
+			unique[cu + 1] = out - begin;
+		},
+		256
+	);
+
+	std::partial_sum(unique.begin(), unique.end(), unique.begin());
+
+	coarse.offsets = unique;
+	coarse.targets.resize(unique.back());
+	coarse.weights.resize(unique.back());
+
+	ParallelFor(
+		coarse_count,
+		[&](size_t cu)
+		{
+			for (size_t i = 0; i < unique[cu + 1] - unique[cu]; i++)
+			{
+				coarse.targets[unique[cu] + i] = arcs[counts[cu] + i].first;
+				coarse.weights[unique[cu] + i] = arcs[counts[cu] + i].second;
+			}
+		},
+		256
+	);
+
+	return coarse;
+}
+
+//========================================
+
+// Spring-electrical refinement with adaptive cooling. Repulsion is limited to a
+// cutoff radius and evaluated through a uniform grid, so an iteration costs
+// O(nodes + edges) instead of O(nodes^2)
+void Refine(const LayoutLevel& level, std::vector<sf::Vector2f>& positions, int iterations, float k, float step)
+{
+	constexpr float cooling = .9f;
+
+	size_t n = level.size();
+	float cutoff = 2 * k;
+
+	std::vector<sf::Vector2f> next(n);
+	std::vector<uint32_t> cell_of(n);
+	std::vector<uint32_t> cell_nodes(n);
+	std::vector<uint32_t> cell_start;
+	std::vector<float> moves(ThreadCount(), 0);
+
+	for (int iteration = 0; iteration < iterations; iteration++)
+	{
+		sf::Vector2f min = positions[0], max = positions[0];
+		for (const auto& position: positions)
+		{
+			min.x = std::min(min.x, position.x);
+			min.y = std::min(min.y, position.y);
+			max.x = std::max(max.x, position.x);
+			max.y = std::max(max.y, position.y);
+		}
+
+		float width  = max.x - min.x + 1;
+		float height = max.y - min.y + 1;
+
+		// Keep the number of cells proportional to the number of nodes
+		float cell = std::max(cutoff, std::sqrt(width * height / (4.f * n + 16)));
+		size_t columns = static_cast<size_t>(width  / cell) + 1;
+		size_t rows    = static_cast<size_t>(height / cell) + 1;
+
+		cell_start.assign(columns * rows + 1, 0);
+		for (size_t u = 0; u < n; u++)
+		{
+			size_t x = static_cast<size_t>((positions[u].x - min.x) / cell);
+			size_t y = static_cast<size_t>((positions[u].y - min.y) / cell);
+
+			cell_of[u] = static_cast<uint32_t>(y * columns + x);
+			cell_start[cell_of[u] + 1]++;
+		}
+
+		std::partial_sum(cell_start.begin(), cell_start.end(), cell_start.begin());
+
+		std::vector<uint32_t> heads(cell_start.begin(), cell_start.end() - 1);
+		for (uint32_t u = 0; u < n; u++)
+			cell_nodes[heads[cell_of[u]]++] = u;
+
+		std::fill(moves.begin(), moves.end(), 0.f);
+		ParallelForRange(
+			n,
+			[&](size_t begin, size_t end, size_t thread)
+			{
+				for (size_t u = begin; u < end; u++)
+				{
+					sf::Vector2f force {};
+					auto position = positions[u];
+
+					long cx = cell_of[u] % columns;
+					long cy = cell_of[u] / columns;
+
+					for (long y = std::max(0l, cy - 1); y <= std::min<long>(rows - 1, cy + 1); y++)
+					{
+						for (long x = std::max(0l, cx - 1); x <= std::min<long>(columns - 1, cx + 1); x++)
+						{
+							size_t c = y * columns + x;
+							for (size_t i = cell_start[c]; i < cell_start[c + 1]; i++)
+							{
+								uint32_t v = cell_nodes[i];
+								if (v == u)
+									continue;
+
+								auto delta = position - positions[v];
+								float distance2 = delta.x * delta.x + delta.y * delta.y;
+
+								if (distance2 > cutoff * cutoff)
+									continue;
+
+								// Separate coincident nodes in a deterministic direction
+								if (distance2 < 1e-4f)
+								{
+									delta = sf::Vector2f(Jitter(u, v), Jitter(v, u)) * .01f * k;
+									distance2 = delta.x * delta.x + delta.y * delta.y + 1e-6f;
+								}
+
+								force += delta * (k * k / distance2);
+							}
+						}
+					}
+
+					for (size_t i = level.offsets[u]; i < level.offsets[u + 1]; i++)
+					{
+						auto delta = positions[level.targets[i]] - position;
+						float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+
+						force += delta * (level.weights[i] * distance / k);
+					}
+
+					float length = std::sqrt(force.x * force.x + force.y * force.y);
+					if (length > 0)
+					{
+						float move = std::min(step, length);
+						next[u] = position + force * (move / length);
+						moves[thread] = std::max(moves[thread], move);
+					}
+
+					else
+						next[u] = position;
+				}
+			}
+		);
+
+		positions.swap(next);
+		step *= cooling;
+
+		if (*std::max_element(moves.begin(), moves.end()) < .01f * k)
+			break;
+	}
+}
+
+//========================================
+
+double Dot(const std::vector<double>& a, const std::vector<double>& b)
+{
+	std::vector<double> partial(ThreadCount(), 0);
+	ParallelForRange(
+		a.size(),
+		[&](size_t begin, size_t end, size_t thread)
+		{
+			double sum = 0;
+			for (size_t i = begin; i < end; i++)
+				sum += a[i] * b[i];
+
+			partial[thread] = sum;
+		}
+	);
+
+	return std::accumulate(partial.begin(), partial.end(), 0.);
+}
+
+// y += alpha * x
+void Axpy(double alpha, const std::vector<double>& x, std::vector<double>& y)
+{
+	ParallelFor(
+		x.size(),
+		[&](size_t i)
+		{
+			y[i] += alpha * x[i];
+		}
+	);
+}
+
+void Scale(double alpha, std::vector<double>& x)
+{
+	ParallelFor(
+		x.size(),
+		[&](size_t i)
+		{
+			x[i] *= alpha;
+		}
+	);
+}
+
+// Generalized Laplacian problem L x = lambda M x of a level, where M holds the node masses.
+// It is solved in its symmetric form with y = M^(1/2) x, shifted by sigma so that the smallest
+// eigenvalues become the largest ones: (sigma*I - M^(-1/2) L M^(-1/2)) y = (sigma - lambda) y.
+// Taking the masses into account keeps the coarse eigenvectors close to the fine ones
+class ShiftedLaplacian
+{
+public:
+	ShiftedLaplacian(const LayoutLevel& level):
+		m_level(level),
+		m_degrees(level.size(), 0),
+		m_scale(level.size(), 0),
+		m_trivial(level.size(), 0)
+	{
+		ParallelFor(
+			level.size(),
+			[&](size_t u)
+			{
+				for (size_t i = level.offsets[u]; i < level.offsets[u + 1]; i++)
+					m_degrees[u] += level.weights[i];
+
+				m_scale[u] = 1 / std::sqrt(static_cast<double>(level.mass[u]));
+			}
+		);
+
+		// Gershgorin bound of the scaled Laplacian spectrum
+		std::vector<double> bounds(level.size());
+		ParallelFor(
+			level.size(),
+			[&](size_t u)
+			{
+				double bound = m_degrees[u] * m_scale[u] * m_scale[u];
+				for (size_t i = level.offsets[u]; i < level.offsets[u + 1]; i++)
+					bound += level.weights[i] * m_scale[u] * m_scale[level.targets[i]];
+
+				bounds[u] = bound;
+			}
+		);
+
+		m_sigma = std::max(*std::max_element(bounds.begin(), bounds.end()), 1.);
+
+		// M^(1/2) * 1 is the trivial eigenvector
+		for (size_t u = 0; u < level.size(); u++)
+			m_trivial[u] = 1 / m_scale[u];
+
+		Scale(1 / std::sqrt(Dot(m_trivial, m_trivial)), m_trivial);
+	}
+
+	double getSigma() const
+	{
+		return m_sigma;
+	}
+
+	void apply(const std::vector<double>& y, std::vector<double>& result) const
+	{
+		ParallelFor(
+			y.size(),
+			[&](size_t u)
+			{
+				double sum = (m_sigma - m_degrees[u] * m_scale[u] * m_scale[u]) * y[u];
+				for (size_t i = m_level.offsets[u]; i < m_level.offsets[u + 1]; i++)
+				{
+					uint32_t v = m_level.targets[i];
+					sum += m_level.weights[i] * m_scale[u] * m_scale[v] * y[v];
+				}
+
+				result[u] = sum;
+			},
+			256
+		);
+	}
+
+	// Removes the component along the trivial eigenvector
+	void deflate(std::vector<double>& y) const
+	{
+		Axpy(-Dot(y, m_trivial), m_trivial, y);
+	}
+
+	// Conversions between the original and the symmetric form
+	void toSymmetric(std::vector<double>& x) const
+	{
+		ParallelFor(
+			x.size(),
+			[&](size_t u)
+			{
+				x[u] /= m_scale[u];
+			}
+		);
+	}
+
+	void fromSymmetric(std::vector<double>& y) const
+	{
+		ParallelFor(
+			y.size(),
+			[&](size_t u)
+			{
+				y[u] *= m_scale[u];
+			}
+		);
+	}
+
+private:
+	const LayoutLevel& m_level;
+	std::vector<double> m_degrees;
+	std::vector<double> m_scale;
+	std::vector<double> m_trivial;
+	double m_sigma = 1;
+
+};
+
+// Cyclic Jacobi eigenvalue algorithm for a small dense symmetric matrix.
+// On return the diagonal of a holds the eigenvalues and the columns of
+// vectors hold the corresponding eigenvectors
+void JacobiEigen(std::vector<double>& a, std::vector<double>& vectors, size_t n)
+{
+	constexpr int max_sweeps = 64;
+
+	vectors.assign(n * n, 0);
+	for (size_t i = 0; i < n; i++)
+		vectors[i * n + i] = 1;
+
+	for (int sweep = 0; sweep < max_sweeps; sweep++)
+	{
+		double off = 0;
+		for (size_t p = 0; p < n; p++)
+			for (size_t q = p + 1; q < n; q++)
+				off += a[p * n + q] * a[p * n + q];
+
+		if (off < 1e-22)
+			break;
+
+		for (size_t p = 0; p < n; p++)
+		{
+			for (size_t q = p + 1; q < n; q++)
+			{
+				double apq = a[p * n + q];
+				if (std::abs(apq) < 1e-300)
+					continue;
+
+				double theta = (a[q * n + q] - a[p * n + p]) / (2 * apq);
+				double t = (theta >= 0 ? 1. : -1.) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+				double c = 1 / std::sqrt(t * t + 1);
+				double s = t * c;
+
+				for (size_t k = 0; k < n; k++)
+				{
+					double akp = a[k * n + p];
+					double akq = a[k * n + q];
+					a[k * n + p] = c * akp - s * akq;
+					a[k * n + q] = s * akp + c * akq;
+				}
+
+				for (size_t k = 0; k < n; k++)
+				{
+					double apk = a[p * n + k];
+					double aqk = a[q * n + k];
+					a[p * n + k] = c * apk - s * aqk;
+					a[q * n + k] = s * apk + c * aqk;
+				}
+
+				for (size_t k = 0; k < n; k++)
+				{
+					double vkp = vectors[k * n + p];
+					double vkq = vectors[k * n + q];
+					vectors[k * n + p] = c * vkp - s * vkq;
+					vectors[k * n + q] = s * vkp + c * vkq;
+				}
+			}
+		}
+	}
+}
+
+//========================================
+
+// Restarted Lanczos iteration with full reorthogonalization. Approximates the
+// eigenvectors of the 2nd and 3rd smallest Laplacian eigenvalues of the level one
+// after another, starting from the given vectors. A converged eigenvector is locked,
+// i.e. kept out of the following Krylov subspaces, so that eigenvalues of multiplicity
+// two (frequent on symmetric graphs) still yield two independent vectors
+std::array<std::vector<double>, 2> LaplacianEigenvectors(
+	const LayoutLevel& level,
+	std::array<std::vector<double>, 2> starts,
+	const SpectralLayoutSettings& settings,
+	int max_restarts
+)
+{
+	size_t n = level.size();
+	std::array<std::vector<double>, 2> result { std::vector<double>(n), std::vector<double>(n) };
+
+	// Too small to have nontrivial eigenvectors
+	if (n < 3)
+		return result;
+
+	size_t m = std::min(settings.krylov_dimension, n - 1);
+	ShiftedLaplacian op(level);
+
+	std::vector<std::vector<double>> locked, basis;
+	std::vector<double> alpha, beta, w(n);
+
+	// Orthogonalizes q against the locked vectors and the current basis and normalizes it.
+	// Returns the norm before normalization, zero if q lies inside the span of the basis
+	auto orthonormalize = [&](std::vector<double>& q) -> double
+	{
+		for (int pass = 0; pass < 2; pass++)
+		{
+			op.deflate(q);
+			for (const auto& v: locked)
+				Axpy(-Dot(q, v), v, q);
+
+			for (const auto& v: basis)
+				Axpy(-Dot(q, v), v, q);
+		}
+
+		double norm = std::sqrt(Dot(q, q));
+		if (norm < 1e-10)
+			return 0;
+
+		Scale(1 / norm, q);
+		return norm;
+	};
+
+	for (size_t r = 0; r < result.size(); r++)
+	{
+		auto& ritz = result[r];
+		std::vector<double> start = std::move(starts[r]);
+		op.toSymmetric(start);
+
+		for (int restart = 0; restart <= max_restarts; restart++)
+		{
+			basis.clear();
+			alpha.clear();
+			beta.clear();
+
+			std::vector<double> q = start;
+			if (!orthonormalize(q))
+			{
+				for (size_t i = 0; i < n; i++)
+					q[i] = Jitter(settings.seed + static_cast<uint32_t>(r), static_cast<uint32_t>(i));
+
+				if (!orthonormalize(q))
+					break;
+			}
+
+			for (size_t j = 0; j + locked.size() < m; j++)
+			{
+				basis.push_back(q);
+
+				op.apply(basis[j], w);
+				alpha.push_back(Dot(w, basis[j]));
+				beta.push_back(orthonormalize(w));
+
+				if (!beta.back())
+				{
+					// Invariant subspace found, continue from a fresh direction
+					for (size_t i = 0; i < n; i++)
+						w[i] = Jitter(settings.seed + static_cast<uint32_t>(j) + 1, static_cast<uint32_t>(i));
+
+					if (!orthonormalize(w))
+						break;
+				}
+
+				q = w;
+			}
+
+			// Largest eigenpair of the projected tridiagonal matrix
+			size_t k = basis.size();
+
+			std::vector<double> tridiagonal(k * k, 0), vectors;
+			for (size_t i = 0; i < k; i++)
+			{
+				tridiagonal[i * k + i] = alpha[i];
+				if (i + 1 < k)
+					tridiagonal[i * k + i + 1] = tridiagonal[(i + 1) * k + i] = beta[i];
+			}
+
+			JacobiEigen(tridiagonal, vectors, k);
+
+			size_t top = 0;
+			for (size_t i = 1; i < k; i++)
+				if (tridiagonal[i * k + i] > tridiagonal[top * k + top])
+					top = i;
+
+			std::fill(ritz.begin(), ritz.end(), 0.);
+			for (size_t i = 0; i < k; i++)
+				Axpy(vectors[i * k + top], basis[i], ritz);
+
+			// Residual norm of a Ritz pair is |beta_k * y_k|
+			double residual = std::abs(beta[k - 1] * vectors[(k - 1) * k + top]);
+			if (k + locked.size() < m || residual < settings.tolerance * op.getSigma())
+				break;
+
+			start = ritz;
+		}
+
+		basis.clear();
+		locked.push_back(ritz);
+	}
+
+	for (auto& vector: result)
+		op.fromSymmetric(vector);
+
+	return result;
+}
+
+//========================================
+
+// Spectral layout of a connected graph. Its Laplacian has a single zero
+// eigenvalue, so the 2nd and 3rd eigenvectors spread out all of the nodes
+std::vector<sf::Vector2f> ConnectedSpectralLayout(const CompactGraph& graph, const SpectralLayoutSettings& settings)
+{
+	constexpr int coarsest_restarts = 64;
+
+	size_t n = graph.getNodeCount();
+	if (n < 3)
+	{
+		std::vector<sf::Vector2f> positions(n);
+		for (size_t i = 0; i < n; i++)
+			positions[i] = sf::Vector2f(i * settings.edge_length, 0);
+
+		return positions;
+	}
+
+	// Small Laplacian eigenvalues are poorly separated on large graphs, so plain
+	// Lanczos would need a huge subspace. Instead the eigenvectors are solved on
+	// a coarsened graph and prolonged level by level as starting vectors
+	MultilevelLayoutSettings coarsening;
+	coarsening.coarsest_size = std::max<size_t>(settings.krylov_dimension, 3);
+
+	std::vector<LayoutLevel> levels;
+	levels.push_back(MakeFinestLevel(graph, true));
+
+	while (levels.back().size() > coarsening.coarsest_size)
+	{
+		auto coarse = Coarsen(levels.back(), coarsening, Hash(settings.seed + levels.size()));
+		if (!coarse)
+			break;
+
+		levels.push_back(std::move(*coarse));
+	}
+
+	std::array<std::vector<double>, 2> starts;
+	for (size_t r = 0; r < starts.size(); r++)
+	{
+		starts[r].resize(levels.back().size());
+		for (size_t i = 0; i < starts[r].size(); i++)
+			starts[r][i] = Jitter(settings.seed + static_cast<uint32_t>(r), static_cast<uint32_t>(i));
+	}
+
+	auto eigenvectors = LaplacianEigenvectors(levels.back(), std::move(starts), settings, coarsest_restarts);
+
+	for (size_t level = levels.size() - 1; level-- > 0; )
+	{
+		const auto& fine = levels[level];
+
+		for (size_t r = 0; r < starts.size(); r++)
+		{
+			starts[r].resize(fine.size());
+			ParallelFor(
+				fine.size(),
+				[&](size_t u)
+				{
+					starts[r][u] = eigenvectors[r][fine.parent[u]];
+				}
+			);
+		}
+
+		eigenvectors = LaplacianEigenvectors(fine, std::move(starts), settings, settings.max_restarts);
+	}
+
+	std::vector<sf::Vector2f> positions(n);
+	for (size_t i = 0; i < n; i++)
+		positions[i] = sf::Vector2f(
+			static_cast<float>(eigenvectors[0][i]),
+			static_cast<float>(eigenvectors[1][i])
+		);
+
+	// Scale the unit eigenvectors so that adjacent nodes are edge_length apart on average
+	double total = 0;
+	size_t count = 0;
+	for (size_t e = 0; e < graph.getEdgeCount(); e++)
+	{
+		const auto& edge = graph.getEdge(static_cast<CompactGraph::index_t>(e));
+		if (edge.a == edge.b)
+			continue;
+
+		auto delta = positions[edge.a] - positions[edge.b];
+		total += std::sqrt(delta.x * delta.x + delta.y * delta.y);
+		count++;
+	}
+
+	float scale = count && total > 0
+		? static_cast<float>(settings.edge_length * count / total)
+		: settings.edge_length * static_cast<float>(n);
+
+	for (auto& position: positions)
+		position *= scale;
+
+	return positions;
+}
+
+//========================================
+
+// Places the layouts of the components side by side in rows, largest first,
+// edge_length apart. Returns the positions in the indices of the whole graph
+std::vector<sf::Vector2f> PackComponents(
+	const Components& components,
+	const std::vector<std::vector<sf::Vector2f>>& layouts,
+	const std::vector<CompactGraph::index_t>& local,
+	float gap
+)
+{
+	size_t count = components.getCount();
+
+	// Corner and size of the bounding box of every layout
+	std::vector<sf::Vector2f> corners(count), sizes(count);
+	double area = 0;
+	float widest = 0;
+
+	for (size_t c = 0; c < count; c++)
+	{
+		sf::Vector2f min = layouts[c].front(), max = layouts[c].front();
+		for (auto position: layouts[c])
+		{
+			min.x = std::min(min.x, position.x);
+			min.y = std::min(min.y, position.y);
+			max.x = std::max(max.x, position.x);
+			max.y = std::max(max.y, position.y);
+		}
+
+		corners[c] = min;
+		sizes[c] = max - min;
+
+		area += static_cast<double>(sizes[c].x + gap) * (sizes[c].y + gap);
+		widest = std::max(widest, sizes[c].x);
+	}
+
+	std::vector<size_t> order(count);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(
+		order.begin(),
+		order.end(),
+		[&](size_t a, size_t b)
+		{
+			return components.sizes[a] > components.sizes[b];
+		}
+	);
+
+	// Rows about as wide as the packing is high
+	float row_width = std::max(static_cast<float>(std::sqrt(area)), widest);
+
+	std::vector<sf::Vector2f> offsets(count);
+	sf::Vector2f cursor;
+	float row_height = 0;
+
+	for (size_t c: order)
+	{
+		if (cursor.x > 0 && cursor.x + sizes[c].x > row_width)
+		{
+			cursor = sf::Vector2f(0, cursor.y + row_height + gap);
+			row_height = 0;
+		}
+
+		offsets[c] = cursor - corners[c];
+
+		cursor.x += sizes[c].x + gap;
+		row_height = std::max(row_height, sizes[c].y);
+	}
+
+	std::vector<sf::Vector2f> positions(components.labels.size());
+	ParallelFor(
+		positions.size(),
+		[&](size_t u)
+		{
+			auto c = components.labels[u];
+			positions[u] = layouts[c][local[u]] + offsets[c];
+		}
+	);
+
+	return positions;
+}
+
+} // namespace
+
+//========================================
+
+std::vector<sf::Vector2f> MultilevelLayout(const CompactGraph& graph, const MultilevelLayoutSettings& settings /*= {}*/)
+{
+	size_t n = graph.getNodeCount();
+	if (n == 0)
+		return {};
+
+	const float k = settings.edge_length;
+
+	std::vector<LayoutLevel> levels;
+	levels.push_back(MakeFinestLevel(graph, false));
+
+	while (levels.back().size() > std::max<size_t>(2, settings.coarsest_size))
+	{
+		auto coarse = Coarsen(levels.back(), settings, Hash(settings.seed + levels.size()));
+		if (!coarse)
+			break;
+
+		levels.push_back(std::move(*coarse));
+	}
+
+	// Lay out the coarsest level from a random start
+	const auto& coarsest = levels.back();
+	float extent = k * std::sqrt(static_cast<float>(coarsest.size()));
+
+	std::vector<sf::Vector2f> positions(coarsest.size());
+	for (uint32_t u = 0; u < coarsest.size(); u++)
+		positions[u] = extent * sf::Vector2f(Jitter(settings.seed, 2 * u), Jitter(settings.seed, 2 * u + 1));
+
+	Refine(coarsest, positions, settings.coarsest_iterations, k, extent);
+
+	// Prolong and refine towards the finest level
+	for (size_t level = levels.size() - 1; level-- > 0; )
+	{
+		const auto& fine = levels[level];
+
+		// Area grows linearly with the number of nodes
+		float scale = std::sqrt(static_cast<float>(fine.size()) / levels[level + 1].size());
+
+		std::vector<sf::Vector2f> prolonged(fine.size());
+		ParallelFor(
+			fine.size(),
+			[&](size_t u)
+			{
+				auto jitter = sf::Vector2f(
+					Jitter(settings.seed + level, 2 * u),
+					Jitter(settings.seed + level, 2 * u + 1)
+				);
+
+				prolonged[u] = scale * positions[fine.parent[u]] + .1f * k * jitter;
+			}
+		);
+
+		positions = std::move(prolonged);
+
+		int iterations = settings.finest_iterations +
+			(settings.coarsest_iterations - settings.finest_iterations) * static_cast<int>(level) / static_cast<int>(levels.size() - 1);
+
+		Refine(fine, positions, iterations, k, k);
+	}
+
+	return positions;
+}
+
+//========================================
+
+std::vector<sf::Vector2f> SpectralLayout(const CompactGraph& graph, const SpectralLayoutSettings& settings /*= {}*/)
+{
+	using index_t = CompactGraph::index_t;
+
+	// Every component adds a zero eigenvalue, whose eigenvector is constant on
+	// the component, so the eigenvectors of a disconnected graph would collapse
+	// the components to points. Each component is laid out on its own instead
+	auto components = ConnectedComponents(graph);
+	if (components.getCount() <= 1)
+		return ConnectedSpectralLayout(graph, settings);
+
+	size_t count = components.getCount();
+
+	// Index of every node within its component
+	std::vector<index_t> local(graph.getNodeCount());
+	std::vector<size_t> filled(count, 0);
+	for (size_t u = 0; u < local.size(); u++)
+		local[u] = static_cast<index_t>(filled[components.labels[u]]++);
+
+	std::vector<std::vector<CompactGraph::EdgeRecord>> edges(count);
+	for (size_t e = 0; e < graph.getEdgeCount(); e++)
+	{
+		auto edge = graph.getEdge(static_cast<index_t>(e));
+		auto c = components.labels[edge.a];
+
+		edge.a = local[edge.a];
+		edge.b = local[edge.b];
+		edges[c].push_back(edge);
+	}
+
+	std::vector<std::vector<sf::Vector2f>> layouts(count);
+	for (size_t c = 0; c < count; c++)
+	{
+		layouts[c] = ConnectedSpectralLayout(CompactGraph(components.sizes[c], edges[c]), settings);
+		edges[c] = {};
+	}
+
+	return PackComponents(components, layouts, local, settings.edge_length);
+}
+
+//========================================
@@ -0,0 +1,368 @@
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include <Graph/Algorithms/MaxFlow.hpp>
+
+//========================================
+
+namespace
+{
+
+using index_t = CompactGraph::index_t;
+using Clock   = std::chrono::steady_clock;
+
+constexpr auto none = std::numeric_limits<index_t>::max();
+
+double Milliseconds(Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+class PushRelabel
+{
+public:
+	PushRelabel(const CompactGraph& graph, index_t src, index_t dst, MaxFlowResult& result):
+		m_graph(graph),
+		m_src(src),
+		m_dst(dst),
+		m_n(graph.getNodeCount()),
+		m_result(result),
+		m_flows(graph.getEdgeCount(), 0),
+		m_excess(m_n, 0),
+		m_heights(m_n, 0),
+		m_current(m_n, 0),
+		m_active(m_n + 1),
+		m_heads(m_n + 1, none),
+		m_next(m_n, none),
+		m_prev(m_n, none),
+		m_counts(m_n + 1, 0)
+	{}
+
+	void run()
+	{
+		auto start = Clock::now();
+
+		// Saturate the arcs leaving the source
+		for (auto arc: m_graph.getArcs(m_src))
+		{
+			if (arc.node == m_src)
+				continue;
+
+			auto capacity = residual(m_src, arc);
+			if (capacity > 0)
+				push(m_src, arc, capacity);
+		}
+
+		m_result.init_time = Milliseconds(start);
+
+		globalRelabel();
+
+		start = Clock::now();
+		double global_relabel_time = m_result.global_relabel_time;
+
+		while (m_highest_active > 0 || !m_active[0].empty())
+		{
+			auto& bucket = m_active[m_highest_active];
+			if (bucket.empty())
+			{
+				m_highest_active--;
+				continue;
+			}
+
+			index_t node = bucket.back();
+			bucket.pop_back();
+
+			// Entries are not removed when a node is relabelled or drained
+			if (m_heights[node] != m_highest_active || m_excess[node] <= 0)
+				continue;
+
+			discharge(node);
+
+			if (m_work >= m_global_relabel_work)
+				globalRelabel();
+		}
+
+		// Global relabelling is timed on its own
+		m_result.discharge_time = Milliseconds(start) - (m_result.global_relabel_time - global_relabel_time);
+		m_result.value = m_excess[m_dst];
+
+		start = Clock::now();
+		findCut();
+		m_result.cut_time = Milliseconds(start);
+	}
+
+private:
+	const CompactGraph& m_graph;
+	index_t m_src, m_dst;
+	size_t m_n;
+
+	MaxFlowResult& m_result;
+
+	// Flow along every edge, positive from its first node to the second
+	std::vector<int64_t> m_flows;
+
+	std::vector<int64_t> m_excess;
+	std::vector<index_t> m_heights;
+
+	// Arc to continue scanning from, per node
+	std::vector<size_t> m_current;
+
+	// Active nodes by height, highest first
+	std::vector<std::vector<index_t>> m_active;
+	index_t m_highest_active = 0;
+
+	// All nodes below height n by height, as doubly linked lists, for the gap heuristic
+	std::vector<index_t> m_heads, m_next, m_prev;
+	std::vector<size_t> m_counts;
+
+	size_t m_work = 0;
+	size_t m_global_relabel_work = 6 * m_n + m_graph.getEdgeCount();
+
+	int64_t capacity(index_t edge) const
+	{
+		return std::max(m_graph.getWeight(edge), 0);
+	}
+
+	// Remaining capacity of the arc from node along arc.edge
+	int64_t residual(index_t node, CompactGraph::Arc arc) const
+	{
+		const auto& edge = m_graph.getEdge(arc.edge);
+
+		// Flow along a directed edge never runs backwards, it can only be cancelled
+		if (node == edge.a)
+			return capacity(arc.edge) - m_flows[arc.edge];
+
+		return edge.directed
+			? m_flows[arc.edge]
+			: capacity(arc.edge) + m_flows[arc.edge];
+	}
+
+	void push(index_t node, CompactGraph::Arc arc, int64_t amount)
+	{
+		m_flows[arc.edge] += node == m_graph.getEdge(arc.edge).a
+			? amount
+			: -amount;
+
+		m_excess[node] -= amount;
+
+		bool activated = m_excess[arc.node] <= 0;
+		m_excess[arc.node] += amount;
+
+		if (activated && arc.node != m_src && arc.node != m_dst && m_heights[arc.node] < m_n)
+			activate(arc.node);
+
+		m_result.pushes++;
+	}
+
+	void activate(index_t node)
+	{
+		m_active[m_heights[node]].push_back(node);
+		m_highest_active = std::max(m_highest_active, m_heights[node]);
+	}
+
+	void link(index_t node)
+	{
+		index_t height = m_heights[node];
+
+		m_prev[node] = none;
+		m_next[node] = m_heads[height];
+
+		if (m_heads[height] != none)
+			m_prev[m_heads[height]] = node;
+
+		m_heads[height] = node;
+		m_counts[height]++;
+	}
+
+	void unlink(index_t node)
+	{
+		index_t height = m_heights[node];
+
+		if (m_prev[node] != none)
+			m_next[m_prev[node]] = m_next[node];
+
+		else
+			m_heads[height] = m_next[node];
+
+		if (m_next[node] != none)
+			m_prev[m_next[node]] = m_prev[node];
+
+		m_counts[height]--;
+	}
+
+	void discharge(index_t node)
+	{
+		auto arcs = m_graph.getArcs(node);
+
+		while (m_excess[node] > 0)
+		{
+			if (m_current[node] == arcs.size())
+			{
+				relabel(node);
+				if (m_heights[node] >= m_n)
+					return;
+
+				continue;
+			}
+
+			auto arc = arcs[m_current[node]];
+			auto available = residual(node, arc);
+
+			if (available > 0 && m_heights[node] == m_heights[arc.node] + 1)
+				push(node, arc, std::min(available, m_excess[node]));
+
+			else
+				m_current[node]++;
+		}
+	}
+
+	void relabel(index_t node)
+	{
+		m_result.relabels++;
+
+		index_t old_height = m_heights[node];
+		index_t height = static_cast<index_t>(m_n);
+
+		auto arcs = m_graph.getArcs(node);
+		for (size_t i = 0; i < arcs.size(); i++)
+		{
+			if (residual(node, arcs[i]) > 0 && m_heights[arcs[i].node] + 1 < height)
+			{
+				height = m_heights[arcs[i].node] + 1;
+				m_current[node] = i;
+			}
+		}
+
+		m_work += arcs.size() + 12;
+
+		unlink(node);
+
+		// Gap: no node is left at the old height, so nothing above it can reach the sink
+		if (m_counts[old_height] == 0)
+		{
+			for (index_t h = old_height + 1; h < m_n; h++)
+			{
+				while (m_heads[h] != none)
+				{
+					index_t lifted = m_heads[h];
+					unlink(lifted);
+					m_heights[lifted] = static_cast<index_t>(m_n);
+					m_result.gap_nodes++;
+				}
+
+				m_active[h].clear();
+			}
+
+			height = static_cast<index_t>(m_n);
+		}
+
+		m_heights[node] = height;
+		if (height < m_n)
+		{
+			link(node);
+			activate(node);
+		}
+	}
+
+	// Exact distances to the sink in the residual graph by a backward search.
+	// Nodes that can not reach the sink get height n and are never touched again
+	void globalRelabel()
+	{
+		auto start = Clock::now();
+		m_result.global_relabels++;
+
+		std::fill(m_heights.begin(), m_heights.end(), static_cast<index_t>(m_n));
+		std::fill(m_heads.begin(), m_heads.end(), none);
+		std::fill(m_counts.begin(), m_counts.end(), 0);
+		for (auto& bucket: m_active)
+			bucket.clear();
+
+		m_highest_active = 0;
+
+		std::vector<index_t> queue { m_dst };
+		m_heights[m_dst] = 0;
+		link(m_dst);
+
+		for (size_t head = 0; head < queue.size(); head++)
+		{
+			index_t node = queue[head];
+			for (auto arc: m_graph.getArcs(node))
+			{
+				if (m_heights[arc.node] != m_n || arc.node == m_src)
+					continue;
+
+				// Arc from the neighbour back to this node
+				if (residual(arc.node, { node, arc.edge }) <= 0)
+					continue;
+
+				m_heights[arc.node] = m_heights[node] + 1;
+				m_current[arc.node] = 0;
+
+				link(arc.node);
+				if (m_excess[arc.node] > 0)
+					activate(arc.node);
+
+				queue.push_back(arc.node);
+			}
+		}
+
+		m_work = 0;
+		m_result.global_relabel_time += Milliseconds(start);
+	}
+
+	// The source side of the minimum cut is everything that can not reach the sink
+	void findCut()
+	{
+		auto& source_side = m_result.source_side;
+		source_side.assign(m_n, true);
+		source_side[m_dst] = false;
+
+		std::vector<index_t> queue { m_dst };
+		for (size_t head = 0; head < queue.size(); head++)
+		{
+			index_t node = queue[head];
+			for (auto arc: m_graph.getArcs(node))
+			{
+				if (!source_side[arc.node] || residual(arc.node, { node, arc.edge }) <= 0)
+					continue;
+
+				source_side[arc.node] = false;
+				queue.push_back(arc.node);
+			}
+		}
+
+		for (index_t edge = 0; edge < m_graph.getEdgeCount(); edge++)
+		{
+			const auto& record = m_graph.getEdge(edge);
+			bool crossing = record.directed
+				? source_side[record.a] && !source_side[record.b]
+				: source_side[record.a] != source_side[record.b];
+
+			if (crossing && capacity(edge) > 0)
+				m_result.cut_edges.push_back(edge);
+		}
+	}
+
+};
+
+} // namespace
+
+//========================================
+
+MaxFlowResult MaximumFlow(const CompactGraph& graph, CompactGraph::index_t src, CompactGraph::index_t dst)
+{
+	MaxFlowResult result;
+	if (src == dst)
+	{
+		result.source_side.assign(graph.getNodeCount(), false);
+		return result;
+	}
+
+	PushRelabel solver(graph, src, dst, result);
+	solver.run();
+
+	return result;
+}
+
+//========================================
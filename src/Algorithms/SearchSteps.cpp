@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include <Graph/Algorithms/SearchSteps.hpp>
+
+//========================================
+
+namespace
+{
+
+using index_t = CompactGraph::index_t;
+using Kind    = SearchStep::Kind;
+
+} // namespace
+
+//========================================
+
+Generator<SearchStep> BreadthFirstSteps(const CompactGraph& graph, CompactGraph::index_t src)
+{
+	std::vector<int64_t> distances(graph.getNodeCount(), -1);
+	std::queue<index_t> queue;
+
+	distances[src] = 0;
+	queue.push(src);
+	co_yield { Kind::Discover, src, SearchStep::no_edge, 0 };
+
+	while (!queue.empty())
+	{
+		index_t node = queue.front();
+		queue.pop();
+
+		for (auto arc: graph.getOutArcs(node))
+		{
+			if (distances[arc.node] >= 0)
+				continue;
+
+			distances[arc.node] = distances[node] + 1;
+			queue.push(arc.node);
+			co_yield { Kind::Discover, arc.node, arc.edge, distances[arc.node] };
+		}
+
+		co_yield { Kind::Settle, node, SearchStep::no_edge, distances[node] };
+	}
+}
+
+Generator<SearchStep> DepthFirstSteps(const CompactGraph& graph, CompactGraph::index_t src)
+{
+	// Path from the source, with the next arc to look at of every node on it
+	struct Frame
+	{
+		index_t node;
+		size_t arc;
+	};
+
+	std::vector<int64_t> order(graph.getNodeCount(), -1);
+	std::vector<Frame> path;
+	int64_t visited = 0;
+
+	order[src] = visited++;
+	path.push_back({ src, 0 });
+	co_yield { Kind::Discover, src, SearchStep::no_edge, 0 };
+
+	while (!path.empty())
+	{
+		auto& frame = path.back();
+		auto arcs = graph.getOutArcs(frame.node);
+
+		while (frame.arc < arcs.size() && order[arcs[frame.arc].node] >= 0)
+			frame.arc++;
+
+		if (frame.arc == arcs.size())
+		{
+			index_t node = frame.node;
+			path.pop_back();
+
+			co_yield { Kind::Settle, node, SearchStep::no_edge, order[node] };
+			continue;
+		}
+
+		auto arc = arcs[frame.arc++];
+		order[arc.node] = visited++;
+
+		// Invalidates frame
+		path.push_back({ arc.node, 0 });
+		co_yield { Kind::Discover, arc.node, arc.edge, order[arc.node] };
+	}
+}
+
+Generator<SearchStep> DijkstraSteps(const CompactGraph& graph, CompactGraph::index_t src)
+{
+	using Entry = std::pair<int64_t, index_t>;
+
+	std::vector<int64_t> distances(graph.getNodeCount(), std::numeric_limits<int64_t>::max());
+	std::vector<bool> settled(graph.getNodeCount(), false);
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+	distances[src] = 0;
+	heap.push({ 0, src });
+	co_yield { Kind::Discover, src, SearchStep::no_edge, 0 };
+
+	while (!heap.empty())
+	{
+		auto [distance, node] = heap.top();
+		heap.pop();
+
+		// Stale entry of a node that got closer after it was pushed
+		if (settled[node])
+			continue;
+
+		settled[node] = true;
+		co_yield { Kind::Settle, node, SearchStep::no_edge, distance };
+
+		for (auto arc: graph.getOutArcs(node))
+		{
+			int64_t next = distance + std::max(graph.getWeight(arc.edge), 0);
+			if (settled[arc.node] || next >= distances[arc.node])
+				continue;
+
+			distances[arc.node] = next;
+			heap.push({ next, arc.node });
+			co_yield { Kind::Discover, arc.node, arc.edge, next };
+		}
+	}
+}
+
+//========================================
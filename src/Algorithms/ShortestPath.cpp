@@ -0,0 +1,312 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <queue>
+
+#include <Graph/Algorithms/ShortestPath.hpp>
+#include <Graph/Algorithms/BreadthFirstSearch.hpp>
+
+//========================================
+
+namespace
+{
+
+using index_t = CompactGraph::index_t;
+using Clock   = std::chrono::steady_clock;
+
+constexpr auto infinite = std::numeric_limits<int64_t>::max();
+constexpr auto no_node  = std::numeric_limits<index_t>::max();
+
+// Dijkstra's search from one end, parents point back towards that end
+class DijkstraSide
+{
+public:
+	std::vector<int64_t> distances;
+	std::vector<CompactGraph::Arc> parents;
+
+	DijkstraSide(const CompactGraph& graph, index_t origin, bool forward, SearchStats& stats):
+		distances(graph.getNodeCount(), infinite),
+		parents(graph.getNodeCount()),
+		m_graph(graph),
+		m_forward(forward),
+		m_stats(stats)
+	{
+		distances[origin] = 0;
+		parents[origin] = { origin, no_node };
+		push(0, origin);
+	}
+
+	bool done() const
+	{
+		return m_heap.empty();
+	}
+
+	// Lower bound of the distances of the nodes not settled yet
+	int64_t getTop() const
+	{
+		return m_heap.top().first;
+	}
+
+	// Settles the closest node, returns it or no_node for a stale heap entry.
+	// Called for every node whose label improves
+	template<typename F>
+	index_t settle(F&& improved)
+	{
+		auto [distance, node] = m_heap.top();
+		m_heap.pop();
+		m_stats.pops++;
+
+		if (distance > distances[node])
+			return no_node;
+
+		m_stats.settled++;
+
+		auto arcs = m_forward
+			? m_graph.getOutArcs(node)
+			: m_graph.getInArcs(node);
+
+		for (auto arc: arcs)
+		{
+			m_stats.relaxed++;
+
+			int64_t next = distance + std::max(m_graph.getWeight(arc.edge), 0);
+			if (next >= distances[arc.node])
+				continue;
+
+			distances[arc.node] = next;
+			parents[arc.node] = { node, arc.edge };
+			push(next, arc.node);
+
+			improved(arc.node);
+		}
+
+		return node;
+	}
+
+private:
+	using Entry = std::pair<int64_t, index_t>;
+
+	const CompactGraph& m_graph;
+	bool m_forward;
+	SearchStats& m_stats;
+
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> m_heap {};
+
+	void push(int64_t distance, index_t node)
+	{
+		m_heap.emplace(distance, node);
+		m_stats.pushes++;
+		m_stats.peak_frontier = std::max(m_stats.peak_frontier, m_heap.size());
+	}
+
+};
+
+// Follows the parents from node back to the origin of the search
+void AppendParents(CompactPath& path, const std::vector<CompactGraph::Arc>& parents, index_t node)
+{
+	for (; parents[node].edge != no_node; node = parents[node].node)
+	{
+		path.edges.push_back(parents[node].edge);
+		path.nodes.push_back(parents[node].node);
+	}
+}
+
+CompactPath BreadthFirstPath(const CompactGraph& graph, index_t src, index_t dst)
+{
+	BreadthFirstSearchSettings settings;
+	settings.target = dst;
+
+	auto search = BreadthFirstSearch(graph, src, settings);
+
+	// Every reached node enters the queue once, the last level is not expanded
+	CompactPath path;
+	path.stats.settled = search.getReachedCount();
+	path.stats.relaxed = search.examined_arcs;
+	path.stats.pushes  = path.stats.settled;
+	path.stats.pops    = path.stats.settled - (search.reached(dst) ? search.level_sizes.back() : 0);
+	path.stats.peak_frontier = *std::max_element(search.level_sizes.begin(), search.level_sizes.end());
+
+	if (!search.reached(dst))
+		return path;
+
+	path.nodes.push_back(dst);
+	AppendParents(path, search.parents, dst);
+
+	std::reverse(path.nodes.begin(), path.nodes.end());
+	std::reverse(path.edges.begin(), path.edges.end());
+
+	return path;
+}
+
+CompactPath DijkstraPath(const CompactGraph& graph, index_t src, index_t dst)
+{
+	CompactPath path;
+	DijkstraSide search(graph, src, true, path.stats);
+
+	while (!search.done() && search.settle([](index_t) {}) != dst);
+
+	if (search.distances[dst] == infinite)
+		return path;
+
+	path.nodes.push_back(dst);
+	AppendParents(path, search.parents, dst);
+
+	std::reverse(path.nodes.begin(), path.nodes.end());
+	std::reverse(path.edges.begin(), path.edges.end());
+
+	return path;
+}
+
+CompactPath BidirectionalDijkstraPath(const CompactGraph& graph, index_t src, index_t dst)
+{
+	CompactPath path;
+	DijkstraSide forward(graph, src, true, path.stats);
+	DijkstraSide backward(graph, dst, false, path.stats);
+
+	// Shortest path through the labelled nodes found so far, and the node where the searches meet on it
+	int64_t best = src == dst ? 0 : infinite;
+	index_t meeting = src;
+
+	auto meet = [&](index_t node)
+	{
+		if (forward.distances[node] == infinite || backward.distances[node] == infinite)
+			return;
+
+		if (forward.distances[node] + backward.distances[node] < best)
+		{
+			best = forward.distances[node] + backward.distances[node];
+			meeting = node;
+		}
+	};
+
+	// Once one side runs out, every path has been seen from it. Otherwise no
+	// path through unsettled nodes can be shorter than the sum of the tops
+	while (!forward.done() && !backward.done() && forward.getTop() + backward.getTop() < best)
+	{
+		if (forward.getTop() <= backward.getTop())
+			forward.settle(meet);
+
+		else
+			backward.settle(meet);
+	}
+
+	if (best == infinite)
+		return path;
+
+	path.nodes.push_back(meeting);
+	AppendParents(path, forward.parents, meeting);
+
+	std::reverse(path.nodes.begin(), path.nodes.end());
+	std::reverse(path.edges.begin(), path.edges.end());
+
+	AppendParents(path, backward.parents, meeting);
+
+	return path;
+}
+
+} // namespace
+
+//========================================
+
+bool CompactPath::empty() const
+{
+	return nodes.empty();
+}
+
+int CompactPath::getWeight(const CompactGraph& graph) const
+{
+	int weight = 0;
+	for (auto edge: edges)
+		weight += graph.getWeight(edge);
+
+	return weight;
+}
+
+//========================================
+
+CompactPath ShortestPath(const CompactGraph& graph, CompactGraph::index_t src, CompactGraph::index_t dst, PathStrategy strategy /*= PathStrategy::BreadthFirst*/)
+{
+	auto start = Clock::now();
+
+	CompactPath path;
+	switch (strategy)
+	{
+		case PathStrategy::BreadthFirst:
+			path = BreadthFirstPath(graph, src, dst);
+			break;
+
+		case PathStrategy::Dijkstra:
+			path = DijkstraPath(graph, src, dst);
+			break;
+
+		case PathStrategy::BidirectionalDijkstra:
+			path = BidirectionalDijkstraPath(graph, src, dst);
+			break;
+	}
+
+	path.stats.time = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	return path;
+}
+
+//========================================
+
+bool ShortestPathTree::reached(CompactGraph::index_t node) const
+{
+	return distances[node] != unreachable;
+}
+
+CompactPath ShortestPathTree::getPath(CompactGraph::index_t node) const
+{
+	CompactPath path;
+	if (!reached(node))
+		return path;
+
+	path.nodes.push_back(node);
+	AppendParents(path, parents, node);
+
+	std::reverse(path.nodes.begin(), path.nodes.end());
+	std::reverse(path.edges.begin(), path.edges.end());
+
+	return path;
+}
+
+ShortestPathTree ShortestPaths(const CompactGraph& graph, CompactGraph::index_t src, PathStrategy strategy /*= PathStrategy::BreadthFirst*/)
+{
+	auto start = Clock::now();
+
+	ShortestPathTree tree;
+	if (strategy == PathStrategy::BreadthFirst)
+	{
+		auto search = BreadthFirstSearch(graph, src);
+
+		tree.stats.settled = search.getReachedCount();
+		tree.stats.relaxed = search.examined_arcs;
+		tree.stats.pushes  = tree.stats.settled;
+		tree.stats.pops    = tree.stats.settled;
+		tree.stats.peak_frontier = *std::max_element(search.level_sizes.begin(), search.level_sizes.end());
+
+		tree.distances.resize(graph.getNodeCount());
+		for (index_t node = 0; node < graph.getNodeCount(); node++)
+			tree.distances[node] = search.reached(node)
+				? search.distances[node]
+				: ShortestPathTree::unreachable;
+
+		tree.parents = std::move(search.parents);
+	}
+
+	else
+	{
+		DijkstraSide search(graph, src, true, tree.stats);
+		while (!search.done())
+			search.settle([](index_t) {});
+
+		tree.distances = std::move(search.distances);
+		tree.parents = std::move(search.parents);
+	}
+
+	tree.stats.time = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	return tree;
+}
+
+//========================================
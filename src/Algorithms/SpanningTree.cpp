@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <numeric>
+
+#include <Graph/Algorithms/SpanningTree.hpp>
+#include <Graph/Algorithms/UnionFind.hpp>
+#include <Graph/Parallel.hpp>
+
+//========================================
+
+namespace
+{
+
+using index_t = CompactGraph::index_t;
+
+// Graphs with fewer edges are not worth the Borůvka rounds
+constexpr size_t boruvka_min_edges = 1 << 16;
+
+// Weight and index of an edge packed so that integer order is the order of
+// the edges: by weight, then by index. The sign bit of the weight is flipped
+// to order negative weights first
+uint64_t EdgeKey(const CompactGraph& graph, index_t edge)
+{
+	auto weight = static_cast<uint32_t>(graph.getWeight(edge)) ^ 0x80000000u;
+	return static_cast<uint64_t>(weight) << 32 | edge;
+}
+
+// Stable parallel LSD radix sort of the edge indices by their weights, 8 bits per pass
+std::vector<index_t> SortByWeight(const CompactGraph& graph)
+{
+	constexpr size_t radix = 256;
+
+	const size_t m = graph.getEdgeCount();
+	const size_t threads = ThreadCount();
+
+	std::vector<index_t> items(m), buffer(m);
+	std::iota(items.begin(), items.end(), 0);
+
+	std::vector<uint32_t> keys(m);
+	ParallelFor(
+		m,
+		[&](size_t edge)
+		{
+			keys[edge] = static_cast<uint32_t>(EdgeKey(graph, static_cast<index_t>(edge)) >> 32);
+		}
+	);
+
+	// counts[thread][digit], turned into scatter offsets
+	std::vector<std::array<size_t, radix>> counts(threads);
+
+	for (unsigned shift = 0; shift < 32; shift += 8)
+	{
+		for (auto& local: counts)
+			local.fill(0);
+
+		// ParallelForRange splits the same range the same way in both passes
+		ParallelForRange(
+			m,
+			[&](size_t begin, size_t end, size_t thread)
+			{
+				for (size_t i = begin; i < end; i++)
+					counts[thread][keys[items[i]] >> shift & (radix - 1)]++;
+			}
+		);
+
+		// All the keys share this digit, the pass would not move anything
+		bool trivial = false;
+		for (size_t digit = 0; digit < radix && !trivial; digit++)
+		{
+			size_t total = 0;
+			for (const auto& local: counts)
+				total += local[digit];
+
+			trivial = total == m;
+		}
+
+		if (trivial)
+			continue;
+
+		size_t offset = 0;
+		for (size_t digit = 0; digit < radix; digit++)
+		{
+			for (auto& local: counts)
+			{
+				size_t count = local[digit];
+				local[digit] = offset;
+				offset += count;
+			}
+		}
+
+		ParallelForRange(
+			m,
+			[&](size_t begin, size_t end, size_t thread)
+			{
+				auto& heads = counts[thread];
+				for (size_t i = begin; i < end; i++)
+					buffer[heads[keys[items[i]] >> shift & (radix - 1)]++] = items[i];
+			}
+		);
+
+		std::swap(items, buffer);
+	}
+
+	return items;
+}
+
+SpanningForest Kruskal(const CompactGraph& graph)
+{
+	SpanningForest forest;
+
+	ConcurrentUnionFind sets(graph.getNodeCount());
+	for (auto edge: SortByWeight(graph))
+	{
+		const auto& record = graph.getEdge(edge);
+		if (sets.unite(record.a, record.b))
+		{
+			forest.edges.push_back(edge);
+			forest.weight += record.weight;
+		}
+	}
+
+	return forest;
+}
+
+SpanningForest Boruvka(const CompactGraph& graph)
+{
+	constexpr auto none = std::numeric_limits<uint64_t>::max();
+
+	const size_t n = graph.getNodeCount();
+	const size_t threads = ThreadCount();
+
+	SpanningForest forest;
+	ConcurrentUnionFind sets(n);
+
+	// Edges that may still connect two components, self loops never do
+	std::vector<index_t> candidates;
+	candidates.reserve(graph.getEdgeCount());
+
+	for (index_t edge = 0; edge < graph.getEdgeCount(); edge++)
+		if (graph.getEdge(edge).a != graph.getEdge(edge).b)
+			candidates.push_back(edge);
+
+	std::vector<index_t> roots(n);
+	std::vector<std::atomic<uint64_t>> lightest(n);
+
+	std::vector<std::vector<index_t>> local_edges(threads), local_candidates(threads);
+
+	while (!candidates.empty())
+	{
+		forest.rounds++;
+
+		ParallelFor(
+			n,
+			[&](size_t node)
+			{
+				roots[node] = sets.find(static_cast<index_t>(node));
+				lightest[node].store(none, std::memory_order_relaxed);
+			}
+		);
+
+		// Lightest outgoing edge of every component
+		ParallelFor(
+			candidates.size(),
+			[&](size_t i)
+			{
+				index_t edge = candidates[i];
+				const auto& record = graph.getEdge(edge);
+
+				uint64_t key = EdgeKey(graph, edge);
+				for (auto root: { roots[record.a], roots[record.b] })
+				{
+					uint64_t current = lightest[root].load(std::memory_order_relaxed);
+					while (key < current && !lightest[root].compare_exchange_weak(current, key, std::memory_order_relaxed));
+				}
+			}
+		);
+
+		// The picked edges form a forest, an edge picked by both of its components
+		// is only added by the first of the two unions
+		ParallelForRange(
+			n,
+			[&](size_t begin, size_t end, size_t thread)
+			{
+				auto& local = local_edges[thread];
+				for (size_t node = begin; node < end; node++)
+				{
+					uint64_t key = lightest[node].load(std::memory_order_relaxed);
+					if (roots[node] != node || key == none)
+						continue;
+
+					auto edge = static_cast<index_t>(key);
+					const auto& record = graph.getEdge(edge);
+
+					if (sets.unite(record.a, record.b))
+						local.push_back(edge);
+				}
+			}
+		);
+
+		for (auto& local: local_edges)
+		{
+			forest.edges.insert(forest.edges.end(), local.begin(), local.end());
+			local.clear();
+		}
+
+		// Drop the edges that ended up inside a component
+		ParallelForRange(
+			candidates.size(),
+			[&](size_t begin, size_t end, size_t thread)
+			{
+				auto& local = local_candidates[thread];
+				for (size_t i = begin; i < end; i++)
+				{
+					const auto& record = graph.getEdge(candidates[i]);
+					if (sets.find(record.a) != sets.find(record.b))
+						local.push_back(candidates[i]);
+				}
+			}
+		);
+
+		candidates.clear();
+		for (auto& local: local_candidates)
+		{
+			candidates.insert(candidates.end(), local.begin(), local.end());
+			local.clear();
+		}
+	}
+
+	// Same order as Kruskal would produce
+	std::sort(
+		forest.edges.begin(),
+		forest.edges.end(),
+		[&](index_t a, index_t b)
+		{
+			return EdgeKey(graph, a) < EdgeKey(graph, b);
+		}
+	);
+
+	for (auto edge: forest.edges)
+		forest.weight += graph.getWeight(edge);
+
+	return forest;
+}
+
+} // namespace
+
+//========================================
+
+SpanningForest MinimumSpanningForest(const CompactGraph& graph, SpanningForestMethod method /*= SpanningForestMethod::Automatic*/)
+{
+	if (method == SpanningForestMethod::Automatic)
+		method = ThreadCount() > 1 && graph.getEdgeCount() >= boruvka_min_edges
+			? SpanningForestMethod::Boruvka
+			: SpanningForestMethod::Kruskal;
+
+	auto forest = method == SpanningForestMethod::Boruvka
+		? Boruvka(graph)
+		: Kruskal(graph);
+
+	// Every tree of n nodes has n - 1 edges
+	forest.trees = graph.getNodeCount() - forest.edges.size();
+	return forest;
+}
+
+//========================================
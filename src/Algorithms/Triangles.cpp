@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <numeric>
+#include <span>
+
+#include <Graph/Algorithms/Triangles.hpp>
+#include <Graph/Parallel.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+//========================================
+
+namespace
+{
+
+using index_t = CompactGraph::index_t;
+
+// Above this size ratio the shorter list is searched for in the longer one
+constexpr size_t galloping_ratio = 32;
+
+// Calls found(x) for every x present in both sorted lists of distinct values
+template<typename F>
+void Intersect(std::span<const index_t> a, std::span<const index_t> b, F&& found)
+{
+	if (a.size() > b.size())
+		std::swap(a, b);
+
+	if (a.size() * galloping_ratio < b.size())
+	{
+		auto from = b.begin();
+		for (auto x: a)
+		{
+			// Exponential search from the previous position, then binary search
+			size_t step = 1;
+			auto bound = from;
+			while (bound < b.end() && *bound < x)
+			{
+				from = bound;
+				bound += std::min<size_t>(step, b.end() - bound);
+				step *= 2;
+			}
+
+			from = std::lower_bound(from, bound, x);
+			if (from == b.end())
+				return;
+
+			if (*from == x)
+				found(x);
+		}
+
+		return;
+	}
+
+	size_t i = 0;
+	size_t j = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+	// Blocks of four are compared all against all, by comparing the block of a
+	// with the four rotations of the block of b. The block with the smaller last
+	// element cannot match anything further on
+	constexpr size_t block = 4;
+
+	while (i + block <= a.size() && j + block <= b.size())
+	{
+		__m128i a_block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a.data() + i));
+		__m128i b_block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b.data() + j));
+
+		__m128i matches = _mm_or_si128(
+			_mm_or_si128(
+				_mm_cmpeq_epi32(a_block, b_block),
+				_mm_cmpeq_epi32(a_block, _mm_shuffle_epi32(b_block, _MM_SHUFFLE(0, 3, 2, 1)))
+			),
+			_mm_or_si128(
+				_mm_cmpeq_epi32(a_block, _mm_shuffle_epi32(b_block, _MM_SHUFFLE(1, 0, 3, 2))),
+				_mm_cmpeq_epi32(a_block, _mm_shuffle_epi32(b_block, _MM_SHUFFLE(2, 1, 0, 3)))
+			)
+		);
+
+		for (int mask = _mm_movemask_ps(_mm_castsi128_ps(matches)); mask; mask &= mask - 1)
+			found(a[i + std::countr_zero(static_cast<unsigned>(mask))]);
+
+		index_t a_last = a[i + block - 1];
+		index_t b_last = b[j + block - 1];
+
+		i += a_last <= b_last ? block : 0;
+		j += b_last <= a_last ? block : 0;
+	}
+#endif
+
+	while (i < a.size() && j < b.size())
+	{
+		if (a[i] < b[j])
+			i++;
+
+		else if (b[j] < a[i])
+			j++;
+
+		else
+		{
+			found(a[i]);
+			i++;
+			j++;
+		}
+	}
+}
+
+} // namespace
+
+//========================================
+
+Triangles CountTriangles(const CompactGraph& graph)
+{
+	const size_t n = graph.getNodeCount();
+
+	// Nodes are renumbered by degree, ties by index, so that
+	// every edge points from the lower number to the higher one
+	std::vector<size_t> degrees(n);
+	ParallelFor(
+		n,
+		[&](size_t node)
+		{
+			degrees[node] = graph.getDegree(static_cast<index_t>(node));
+		}
+	);
+
+	size_t max_degree = n
+		? *std::max_element(degrees.begin(), degrees.end())
+		: 0;
+
+	std::vector<size_t> bins(max_degree + 2, 0);
+	for (auto degree: degrees)
+		bins[degree + 1]++;
+
+	std::partial_sum(bins.begin(), bins.end(), bins.begin());
+
+	std::vector<index_t> ranks(n);
+	std::vector<index_t> nodes(n);
+	for (index_t node = 0; node < n; node++)
+	{
+		ranks[node] = static_cast<index_t>(bins[degrees[node]]++);
+		nodes[ranks[node]] = node;
+	}
+
+	// Sorted out-neighbours of every rank, without the parallel edges
+	std::vector<size_t> offsets(n + 1, 0);
+	for (index_t rank = 0; rank < n; rank++)
+	{
+		size_t count = 0;
+		for (auto arc: graph.getArcs(nodes[rank]))
+			count += ranks[arc.node] > rank;
+
+		offsets[rank + 1] = offsets[rank] + count;
+	}
+
+	std::vector<index_t> targets(offsets.back());
+	std::vector<size_t> lengths(n);
+
+	ParallelFor(
+		n,
+		[&](size_t rank)
+		{
+			auto begin = targets.begin() + offsets[rank];
+			auto end = begin;
+
+			for (auto arc: graph.getArcs(nodes[rank]))
+				if (ranks[arc.node] > rank)
+					*end++ = ranks[arc.node];
+
+			std::sort(begin, end);
+			lengths[rank] = std::unique(begin, end) - begin;
+		},
+		256
+	);
+
+	auto out = [&](index_t rank)
+	{
+		return std::span<const index_t>(targets.data() + offsets[rank], lengths[rank]);
+	};
+
+	// Distinct neighbours, counted at both ends of the oriented edges
+	std::vector<size_t> simple_degrees(lengths);
+	std::vector<uint64_t> counts(n, 0);
+
+	ParallelFor(
+		n,
+		[&](size_t rank)
+		{
+			for (auto target: out(static_cast<index_t>(rank)))
+				std::atomic_ref(simple_degrees[target]).fetch_add(1, std::memory_order_relaxed);
+		},
+		256
+	);
+
+	ParallelFor(
+		n,
+		[&](size_t rank)
+		{
+			uint64_t own = 0;
+			auto neighbours = out(static_cast<index_t>(rank));
+
+			// The third node comes after the middle one in both lists
+			for (size_t k = 0; k < neighbours.size(); k++)
+			{
+				index_t middle = neighbours[k];
+				uint64_t found = 0;
+
+				Intersect(
+					neighbours.subspan(k + 1),
+					out(middle),
+					[&](index_t last)
+					{
+						std::atomic_ref(counts[last]).fetch_add(1, std::memory_order_relaxed);
+						found++;
+					}
+				);
+
+				if (found)
+					std::atomic_ref(counts[middle]).fetch_add(found, std::memory_order_relaxed);
+
+				own += found;
+			}
+
+			if (own)
+				std::atomic_ref(counts[rank]).fetch_add(own, std::memory_order_relaxed);
+		},
+		64
+	);
+
+	Triangles result;
+	result.nodes.resize(n);
+	result.clustering.resize(n);
+
+	uint64_t corners = 0;
+	uint64_t triples = 0;
+	double clustering_sum = 0;
+
+	for (index_t node = 0; node < n; node++)
+	{
+		index_t rank = ranks[node];
+		uint64_t degree = simple_degrees[rank];
+		uint64_t pairs = degree * (degree - 1) / 2;
+
+		result.nodes[node] = counts[rank];
+		result.clustering[node] = pairs
+			? static_cast<double>(counts[rank]) / pairs
+			: 0;
+
+		corners += counts[rank];
+		triples += pairs;
+		clustering_sum += result.clustering[node];
+	}
+
+	result.total = corners / 3;
+	result.average_clustering = n
+		? clustering_sum / n
+		: 0;
+
+	result.transitivity = triples
+		? static_cast<double>(corners) / triples
+		: 0;
+
+	return result;
+}
+
+//========================================
@@ -0,0 +1,1021 @@
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <numeric>
+#include <tuple>
+
+#include <Graph/Analyzer.hpp>
+#include <Graph/Algorithms/BreadthFirstSearch.hpp>
+#include <Graph/ImGuiExtra.hpp>
+#include <Graph/Config.hpp>
+#include <Graph/Utils.hpp>
+
+//========================================
+
+namespace
+{
+
+// Hues stepped by the golden ratio stay apart for any number of colours
+sf::Color CategoryColor(size_t index)
+{
+	constexpr double golden_ratio = .618033988749895;
+
+	double hue = index * golden_ratio;
+	return HSV(static_cast<int>((hue - static_cast<size_t>(hue)) * 255), 0xB0, 0xF0);
+}
+
+// Colour of the given level out of level_count, from red near the source to blue far away
+sf::Color LevelColor(size_t level, size_t level_count)
+{
+	float t = level_count > 1
+		? static_cast<float>(level) / (level_count - 1)
+		: 0;
+
+	return HSV(static_cast<int>(t * 170), 0xC0, 0xF0);
+}
+
+ImVec4 ToImVec4(sf::Color color)
+{
+	return ImVec4(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f);
+}
+
+} // namespace
+
+//========================================
+
+Analyzer::Analyzer(ObjectManager& manager):
+	m_object_manager(manager),
+	m_search_animation(manager)
+{}
+
+//========================================
+
+void Analyzer::showMenu()
+{
+	if (ImGui::MenuItem("Connected components"))
+		findComponents();
+
+	if (ImGui::MenuItem("Breadth-first search"))
+		showBreadthFirstSearch();
+
+	if (ImGui::MenuItem("Animated search"))
+		m_search_animation.show();
+
+	if (ImGui::MenuItem("Colouring"))
+		findColoring();
+
+	if (ImGui::MenuItem("Statistics"))
+	{
+		updateStatistics();
+		m_statistics_show = true;
+	}
+
+	if (ImGui::MenuItem("Centrality"))
+		m_centrality_show = true;
+
+	ImGui::Separator();
+
+	if (ImGui::MenuItem("Reset appearance"))
+		resetAppearance();
+}
+
+void Analyzer::update()
+{
+	m_search_animation.update();
+}
+
+bool Analyzer::isAnimating() const
+{
+	return m_search_animation.isPlaying();
+}
+
+void Analyzer::processInterface()
+{
+	m_search_animation.processInterface();
+
+	if (m_components_show)
+	{
+		if (ImGui::Begin("Connected components", &m_components_show))
+		{
+			// Follow the edits of the graph while the window is open, the weights do not matter
+			if (m_object_manager.getTopologyVersion() != m_components_version)
+				findComponents(false);
+
+			// Strongly connected components differ only when some edges are directed
+			if (ImGui::Checkbox("Strongly connected", &m_components_strong))
+				findComponents();
+
+			const auto& components = m_components;
+
+			ImGui::Text("Components: %zu", components.getCount());
+			ImGui::Text("Time: %.2f ms", m_components_time);
+
+			if (
+				ImGui::BeginTable(
+					"table_components",
+					3,
+					ImGuiTableFlags_ScrollY   |
+					ImGuiTableFlags_Borders   |
+					ImGuiTableFlags_Resizable
+				)
+			)
+			{
+				ImGui::TableSetupScrollFreeze(0, 1);
+				ImGui::TableSetupColumn("#");
+				ImGui::TableSetupColumn("Colour");
+				ImGui::TableSetupColumn("Nodes");
+				ImGui::TableHeadersRow();
+
+				// Imported graphs can have a component per node
+				ImGuiListClipper clipper;
+				clipper.Begin(static_cast<int>(m_components_order.size()));
+
+				while (clipper.Step())
+				{
+					for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+					{
+						size_t component = m_components_order[row];
+
+						ImGui::TableNextRow();
+						ImGui::PushID(row);
+
+						ImGui::TableNextColumn();
+						ImGui::Text("%zu", component);
+
+						ImGui::TableNextColumn();
+						ImGui::ColorButton("##color", ToImVec4(m_components_colors[component]));
+
+						ImGui::TableNextColumn();
+						ImGui::Text("%zu", components.sizes[component]);
+
+						ImGui::PopID();
+					}
+				}
+
+				clipper.End();
+				ImGui::EndTable();
+			}
+		}
+
+		ImGui::End();
+	}
+
+	if (m_msf_show)
+	{
+		if (ImGui::Begin("Minimum spanning forest", &m_msf_show))
+		{
+			static const char* methods[] = {
+				"Automatic",
+				"Borůvka",
+				"Kruskal"
+			};
+
+			if (ImGui::Combo("Method", &m_msf_method, methods, std::size(methods)))
+				findSpanningForest();
+
+			ImGui::Text("Total weight: %lld", static_cast<long long>(m_msf.weight));
+			ImGui::Text("Edges: %zu", m_msf.edges.size());
+			ImGui::Text("Trees: %zu", m_msf.trees);
+
+			if (m_msf.rounds)
+				ImGui::Text("Borůvka rounds: %zu", m_msf.rounds);
+
+			ImGui::Text("Time: %.2f ms", m_msf_time);
+
+			if (ImGui::Button("Clear highlight"))
+			{
+				clearHighlight();
+				m_msf_show = false;
+			}
+		}
+
+		ImGui::End();
+	}
+
+	if (m_statistics_show)
+	{
+		if (ImGui::Begin("Statistics", &m_statistics_show))
+		{
+			if (m_statistics_version != m_object_manager.getGraphVersion())
+				updateStatistics();
+
+			const auto& graph = m_object_manager.getGraph();
+			size_t n = graph.getNodeCount();
+
+			ImGui::Text("Nodes: %zu", n);
+			ImGui::Text("Edges: %zu", graph.getEdgeCount());
+			ImGui::Text("Components: %zu", m_object_manager.getComponents().getCount());
+			ImGui::Text("Average degree: %.2f", n ? 2. * graph.getEdgeCount() / n : 0.);
+			ImGui::Text("Max degree: %zu", m_max_degree);
+
+			ImGui::Separator();
+			ImGui::Text("Triangles: %llu", static_cast<unsigned long long>(m_triangles.total));
+			ImGui::Text("Transitivity: %.4f", m_triangles.transitivity);
+			ImGui::SetItemTooltip("Fraction of the connected triples of nodes that are closed into triangles");
+
+			ImGui::Text("Average clustering: %.4f", m_triangles.average_clustering);
+			ImGui::Text("Time: %.2f ms", m_statistics_time);
+
+			static const char* colorings[] = {
+				"None",
+				"Triangles",
+				"Clustering"
+			};
+
+			if (ImGui::Combo("Colour nodes by", &m_statistics_coloring, colorings, std::size(colorings)))
+				applyStatisticsColoring();
+		}
+
+		ImGui::End();
+	}
+
+	if (m_coloring_show)
+	{
+		if (ImGui::Begin("Colouring", &m_coloring_show))
+		{
+			static const char* orders[] = {
+				"Natural",
+				"Largest first",
+				"Smallest last"
+			};
+
+			if (ImGui::Combo("Order", &m_coloring_order, orders, std::size(orders)))
+				findColoring();
+
+			if (ImGui::Button("Refresh"))
+				findColoring();
+
+			ImGui::Separator();
+			ImGui::Text("Colours: %zu", m_coloring_count);
+			ImGui::Text("Rounds: %zu", m_coloring_rounds);
+			ImGui::Text("Conflicts: %zu", m_coloring_conflicts);
+			ImGui::Text("Time: %.2f ms", m_coloring_time);
+		}
+
+		ImGui::End();
+	}
+
+	if (m_communities_show)
+	{
+		if (ImGui::Begin("Communities", &m_communities_show))
+		{
+			ImGui::InputDouble("Resolution", &m_louvain_settings.resolution, .1, 1, "%.2f");
+			ImGui::SetItemTooltip("Values above 1 favour smaller communities");
+
+			m_louvain_settings.resolution = std::max(m_louvain_settings.resolution, .01);
+
+			if (ImGui::Button("Run"))
+				findCommunities();
+
+			ImGui::Separator();
+			ImGui::Text("Communities: %zu", m_communities_count);
+			ImGui::Text("Time: %.2f ms", m_communities_time);
+
+			if (
+				ImGui::BeginTable(
+					"table_communities_levels",
+					4,
+					ImGuiTableFlags_Borders |
+					ImGuiTableFlags_Resizable
+				)
+			)
+			{
+				ImGui::TableSetupColumn("Level");
+				ImGui::TableSetupColumn("Communities");
+				ImGui::TableSetupColumn("Modularity");
+				ImGui::TableSetupColumn("Passes");
+				ImGui::TableHeadersRow();
+
+				for (size_t i = 0; i < m_communities_levels.size(); i++)
+				{
+					const auto& level = m_communities_levels[i];
+
+					ImGui::TableNextRow();
+
+					ImGui::TableNextColumn();
+					ImGui::Text("%zu", i + 1);
+
+					ImGui::TableNextColumn();
+					ImGui::Text("%zu", level.communities);
+
+					ImGui::TableNextColumn();
+					ImGui::Text("%.4f", level.modularity);
+
+					ImGui::TableNextColumn();
+					ImGui::Text("%d", level.passes);
+				}
+
+				ImGui::EndTable();
+			}
+		}
+
+		ImGui::End();
+	}
+
+	if (m_centrality_show)
+	{
+		if (ImGui::Begin("Centrality", &m_centrality_show))
+		{
+			static const char* methods[] = {
+				"Betweenness",
+				"PageRank",
+				"Katz",
+				"Eigenvector",
+				"Closeness",
+				"Harmonic"
+			};
+
+			ImGui::Combo("Method", &m_centrality_method, methods, std::size(methods));
+
+			switch (static_cast<CentralityMethod>(m_centrality_method))
+			{
+				case CentralityMethod::Betweenness:
+					ImGui::InputScalar("Samples", ImGuiDataType_U64, &m_betweenness_settings.samples);
+					ImGui::SetItemTooltip("Number of sources to estimate from, 0 searches from every node");
+
+					ImGui::InputScalar("Seed", ImGuiDataType_U64, &m_betweenness_settings.seed);
+					break;
+
+				case CentralityMethod::PageRank:
+				case CentralityMethod::Katz:
+				case CentralityMethod::Eigenvector:
+				{
+					auto& settings = m_power_iteration_settings;
+					auto method = static_cast<CentralityMethod>(m_centrality_method);
+
+					if (method == CentralityMethod::PageRank)
+						ImGui::SliderScalar("Damping", ImGuiDataType_Double, &settings.damping, &pagerank_min_damping, &pagerank_max_damping);
+
+					if (method == CentralityMethod::Katz)
+					{
+						ImGui::InputDouble("Alpha", &settings.alpha, 0, 0, "%g");
+						ImGui::SetItemTooltip("Must be below 1 / largest eigenvalue of the adjacency matrix");
+
+						ImGui::InputDouble("Beta", &settings.beta, 0, 0, "%g");
+					}
+
+					ImGui::InputDouble("Tolerance", &settings.tolerance, 0, 0, "%g");
+					ImGui::InputInt("Max iterations", &settings.max_iterations);
+					ImGui::Checkbox("Warm start", &m_warm_start);
+					ImGui::SetItemTooltip("Start from the previous result of the same method");
+
+					settings.max_iterations = std::max(settings.max_iterations, 1);
+					break;
+				}
+
+				case CentralityMethod::Closeness:
+				case CentralityMethod::Harmonic:
+				{
+					auto& settings = m_hyperball_settings;
+
+					ImGui::SliderScalar("Registers (log2)", ImGuiDataType_U32, &settings.log2_registers, &config::hyperball_log2_registers_min, &config::hyperball_log2_registers_max);
+					ImGui::SetItemTooltip("More registers lower the error of the estimates at the cost of memory");
+
+					ImGui::InputScalar("Max distance", ImGuiDataType_U64, &settings.max_iterations);
+					ImGui::SetItemTooltip("0 runs until every ball stops growing");
+
+					ImGui::InputScalar("Seed", ImGuiDataType_U64, &settings.seed);
+					break;
+				}
+			}
+
+			if (ImGui::Button("Run"))
+				runCentrality();
+
+			if (!m_centrality.empty())
+			{
+				ImGui::Separator();
+				ImGui::Text("%s", m_centrality_info.c_str());
+				ImGui::Text("Time: %.2f ms", m_centrality_time);
+
+				if (!m_neighbourhood.empty())
+				{
+					ImGui::Text("Effective diameter: %.2f", m_effective_diameter);
+					ImGui::PlotLines(
+						"##neighbourhood",
+						m_neighbourhood.data(),
+						static_cast<int>(m_neighbourhood.size()),
+						0,
+						"Pairs within distance",
+						0,
+						m_neighbourhood.back(),
+						ImVec2(ImGui::GetContentRegionAvail().x, config::neighbourhood_plot_height)
+					);
+				}
+
+				showCentralityTable();
+			}
+		}
+
+		ImGui::End();
+	}
+
+	if (m_bfs_show)
+	{
+		if (ImGui::Begin("Breadth-first search", &m_bfs_show))
+		{
+			ImGui::InputText("Source", &m_bfs_source);
+			ImGui::SameLine();
+
+			if (ImGui::Button("Run"))
+				runBreadthFirstSearch();
+
+			if (!m_bfs_error.empty())
+				ImGui::TextColored(ImVec4(1, .3f, .3f, 1), "%s", m_bfs_error.c_str());
+
+			else if (!m_bfs_level_sizes.empty())
+			{
+				ImGui::Text("Reached: %zu", std::accumulate(m_bfs_level_sizes.begin(), m_bfs_level_sizes.end(), size_t(0)));
+				ImGui::Text("Levels: %zu (%zu bottom-up)", m_bfs_level_sizes.size(), m_bfs_bottom_up_levels);
+				ImGui::Text("Time: %.2f ms", m_bfs_time);
+
+				if (
+					ImGui::BeginTable(
+						"table_bfs_levels",
+						3,
+						ImGuiTableFlags_ScrollY   |
+						ImGuiTableFlags_Borders   |
+						ImGuiTableFlags_Resizable
+					)
+				)
+				{
+					ImGui::TableSetupScrollFreeze(0, 1);
+					ImGui::TableSetupColumn("Distance");
+					ImGui::TableSetupColumn("Colour");
+					ImGui::TableSetupColumn("Nodes");
+					ImGui::TableHeadersRow();
+
+					ImGuiListClipper clipper;
+					clipper.Begin(static_cast<int>(m_bfs_level_sizes.size()));
+
+					while (clipper.Step())
+					{
+						for (int level = clipper.DisplayStart; level < clipper.DisplayEnd; level++)
+						{
+							ImGui::TableNextRow();
+							ImGui::PushID(level);
+
+							ImGui::TableNextColumn();
+							ImGui::Text("%d", level);
+
+							ImGui::TableNextColumn();
+							ImGui::ColorButton("##color", ToImVec4(LevelColor(level, m_bfs_level_sizes.size())));
+
+							ImGui::TableNextColumn();
+							ImGui::Text("%zu", m_bfs_level_sizes[level]);
+
+							ImGui::PopID();
+						}
+					}
+
+					clipper.End();
+					ImGui::EndTable();
+				}
+			}
+		}
+
+		ImGui::End();
+	}
+}
+
+//========================================
+
+void Analyzer::findComponents(bool recolor /*= true*/)
+{
+	// Marked up to date right away, so that the window does not start it again every frame
+	m_components_version = m_object_manager.getTopologyVersion();
+	m_components_recolor |= recolor;
+
+	m_object_manager.runGraphTask(
+		"Components",
+		[strong = m_components_strong](const ObjectGraph& graph, TaskContext&)
+		{
+			return strong
+				? StronglyConnectedComponents(graph)
+				: ConnectedComponents(graph);
+		},
+		[this](const ObjectGraph& graph, Components& components, float time)
+		{
+			m_components_time = time;
+
+			std::vector<size_t> ids(graph.getNodeCount());
+			for (CompactGraph::index_t node = 0; node < graph.getNodeCount(); node++)
+				ids[node] = graph.getNodeObject(node)->getID();
+
+			// Edits that keep every node in its component leave the colours,
+			// those of the other analyses included, as they are
+			bool changed = m_components_recolor || ids != m_components_ids || components.labels != m_components.labels;
+
+			m_components = std::move(components);
+			m_components_ids = std::move(ids);
+
+			m_components_colors.resize(m_components.getCount());
+			for (size_t i = 0; i < m_components_colors.size(); i++)
+				m_components_colors[i] = CategoryColor(i);
+
+			if (changed)
+			{
+				for (CompactGraph::index_t node = 0; node < graph.getNodeCount(); node++)
+					graph.getNodeObject(node)->setColor(m_components_colors[m_components.labels[node]]);
+
+				m_components_recolor = false;
+			}
+
+			// Largest components first
+			m_components_order.resize(m_components.getCount());
+			std::iota(m_components_order.begin(), m_components_order.end(), 0);
+			std::stable_sort(
+				m_components_order.begin(),
+				m_components_order.end(),
+				[&](size_t a, size_t b)
+				{
+					return m_components.sizes[a] > m_components.sizes[b];
+				}
+			);
+		}
+	);
+
+	m_components_show = true;
+}
+
+void Analyzer::updateStatistics()
+{
+	// Marked up to date right away, so that the window does not start it again every frame
+	m_statistics_version = m_object_manager.getGraphVersion();
+
+	m_object_manager.runGraphTask(
+		"Statistics",
+		[](const ObjectGraph& graph, TaskContext&)
+		{
+			return CountTriangles(graph);
+		},
+		[this, snapshot = m_object_manager.getGraphSnapshot()](const ObjectGraph& graph, Triangles& triangles, float time)
+		{
+			m_triangles = std::move(triangles);
+			m_statistics_graph = snapshot;
+			m_statistics_time = time;
+
+			m_max_degree = 0;
+			for (CompactGraph::index_t node = 0; node < graph.getNodeCount(); node++)
+				m_max_degree = std::max(m_max_degree, graph.getDegree(node));
+
+			applyStatisticsColoring();
+		}
+	);
+}
+
+void Analyzer::applyStatisticsColoring()
+{
+	// Triangles are counted on a snapshot, the objects it refers to outlive the edits
+	if (!m_statistics_graph)
+		return;
+
+	const auto& graph = *m_statistics_graph;
+	switch (static_cast<StatisticsColoring>(m_statistics_coloring))
+	{
+		case StatisticsColoring::None:
+			break;
+
+		case StatisticsColoring::Triangles:
+		{
+			std::vector<double> scores(m_triangles.nodes.begin(), m_triangles.nodes.end());
+			applyScores(graph, scores);
+			break;
+		}
+
+		case StatisticsColoring::Clustering:
+			applyScores(graph, m_triangles.clustering);
+			break;
+	}
+}
+
+void Analyzer::findColoring()
+{
+	m_object_manager.runGraphTask(
+		"Colouring",
+		[order = static_cast<ColoringOrder>(m_coloring_order)](const ObjectGraph& graph, TaskContext&)
+		{
+			return GreedyColoring(graph, order);
+		},
+		[this](const ObjectGraph& graph, Coloring& coloring, float time)
+		{
+			m_coloring_time = time;
+			m_coloring_count = coloring.getCount();
+			m_coloring_rounds = coloring.rounds;
+			m_coloring_conflicts = coloring.conflicts;
+
+			std::vector<sf::Color> colors(coloring.getCount());
+			for (size_t i = 0; i < colors.size(); i++)
+				colors[i] = CategoryColor(i);
+
+			for (CompactGraph::index_t node = 0; node < graph.getNodeCount(); node++)
+				graph.getNodeObject(node)->setColor(colors[coloring.colors[node]]);
+		}
+	);
+
+	m_coloring_show = true;
+}
+
+void Analyzer::findSpanningForest()
+{
+	m_object_manager.runGraphTask(
+		"Spanning forest",
+		[method = static_cast<SpanningForestMethod>(m_msf_method)](const ObjectGraph& graph, TaskContext&)
+		{
+			return MinimumSpanningForest(graph, method);
+		},
+		[this](const ObjectGraph& graph, SpanningForest& forest, float time)
+		{
+			m_msf = std::move(forest);
+			m_msf_time = time;
+
+			clearHighlight();
+			for (auto edge: m_msf.edges)
+				graph.getEdgeObject(edge)->setHighlight(true);
+		}
+	);
+
+	m_msf_show = true;
+}
+
+void Analyzer::findCommunities()
+{
+	m_object_manager.runGraphTask(
+		"Communities",
+		[settings = m_louvain_settings](const ObjectGraph& graph, TaskContext& context) mutable
+		{
+			settings.context = &context;
+			return LouvainCommunities(graph, settings);
+		},
+		[this](const ObjectGraph& graph, Communities& communities, float time)
+		{
+			m_communities_time = time;
+			m_communities_levels = std::move(communities.levels);
+			m_communities_count = communities.getCount();
+
+			std::vector<sf::Color> colors(communities.getCount());
+			for (size_t i = 0; i < colors.size(); i++)
+				colors[i] = CategoryColor(i);
+
+			for (CompactGraph::index_t node = 0; node < graph.getNodeCount(); node++)
+				graph.getNodeObject(node)->setColor(colors[communities.labels[node]]);
+		}
+	);
+
+	m_communities_show = true;
+}
+
+void Analyzer::runCentrality()
+{
+	switch (static_cast<CentralityMethod>(m_centrality_method))
+	{
+		case CentralityMethod::Betweenness:
+			m_object_manager.runGraphTask(
+				"Centrality",
+				[settings = m_betweenness_settings](const ObjectGraph& graph, TaskContext& context) mutable
+				{
+					settings.context = &context;
+					return BetweennessCentrality(graph, settings);
+				},
+				[this, snapshot = m_object_manager.getGraphSnapshot()](const ObjectGraph& graph, Betweenness& betweenness, float time)
+				{
+					m_centrality_time = time;
+					m_centrality = std::move(betweenness.nodes);
+					m_centrality_info = std::format("Betweenness from {} of {} sources", betweenness.sources, graph.getNodeCount());
+					m_neighbourhood.clear();
+
+					applyScores(graph, m_centrality, betweenness.edges);
+					rankCentrality(snapshot);
+				}
+			);
+
+			break;
+
+		case CentralityMethod::PageRank:
+		case CentralityMethod::Katz:
+		case CentralityMethod::Eigenvector:
+		{
+			static constexpr PowerIterationResult (*functions[])(const CompactGraph&, const PowerIterationSettings&, std::span<const double>) = {
+				nullptr,
+				PageRank,
+				KatzCentrality,
+				EigenvectorCentrality
+			};
+
+			// Mapped onto the indices of the snapshot the task is about to take
+			auto start = m_warm_start && m_warm_start_method == m_centrality_method
+				? getWarmStart(m_object_manager.getGraph())
+				: std::vector<double>();
+
+			bool warm = !start.empty();
+
+			m_object_manager.runGraphTask(
+				"Centrality",
+				[function = functions[m_centrality_method], settings = m_power_iteration_settings, start = std::move(start)](const ObjectGraph& graph, TaskContext& context) mutable
+				{
+					settings.context = &context;
+					return function(graph, settings, start);
+				},
+				[this, warm, method = m_centrality_method, snapshot = m_object_manager.getGraphSnapshot()](const ObjectGraph& graph, PowerIterationResult& result, float time)
+				{
+					m_centrality_time = time;
+					m_centrality = std::move(result.scores);
+					m_centrality_info = std::format(
+						"{} after {} iterations{}, residual {:.3g}",
+						result.converged ? "Converged" : "Not converged",
+						result.iterations,
+						warm ? " from the previous result" : "",
+						result.residual
+					);
+
+					m_neighbourhood.clear();
+
+					m_warm_start_method = method;
+					m_warm_start_scores.clear();
+					m_warm_start_scores.reserve(m_centrality.size());
+
+					for (CompactGraph::index_t node = 0; node < m_centrality.size(); node++)
+						m_warm_start_scores.emplace(graph.getNodeObject(node)->getID(), m_centrality[node]);
+
+					applyScores(graph, m_centrality);
+					rankCentrality(snapshot);
+				}
+			);
+
+			break;
+		}
+
+		case CentralityMethod::Closeness:
+		case CentralityMethod::Harmonic:
+			m_object_manager.runGraphTask(
+				"Centrality",
+				[settings = m_hyperball_settings](const ObjectGraph& graph, TaskContext& context) mutable
+				{
+					settings.context = &context;
+					return HyperBall(graph, settings);
+				},
+				[this, closeness = static_cast<CentralityMethod>(m_centrality_method) == CentralityMethod::Closeness, snapshot = m_object_manager.getGraphSnapshot()](const ObjectGraph& graph, HyperBallResult& hyperball, float time)
+				{
+					m_centrality_time = time;
+					m_centrality = closeness
+						? std::move(hyperball.closeness)
+						: std::move(hyperball.harmonic);
+
+					m_centrality_info = std::format(
+						"Balls {} after radius {}",
+						hyperball.converged ? "stopped growing" : "still growing",
+						hyperball.iterations
+					);
+
+					m_effective_diameter = hyperball.getEffectiveDiameter();
+					m_neighbourhood.assign(hyperball.neighbourhood.begin(), hyperball.neighbourhood.end());
+
+					applyScores(graph, m_centrality);
+					rankCentrality(snapshot);
+				}
+			);
+
+			break;
+	}
+}
+
+void Analyzer::rankCentrality(std::shared_ptr<const ObjectGraph> graph)
+{
+	m_centrality_graph = std::move(graph);
+
+	std::vector<CompactGraph::index_t> order(m_centrality.size());
+	std::iota(order.begin(), order.end(), 0);
+
+	// The table only shows the top nodes, sorting the rest is not needed
+	size_t top = std::min(order.size(), config::centrality_table_size);
+	std::partial_sort(
+		order.begin(),
+		order.begin() + top,
+		order.end(),
+		[&](CompactGraph::index_t a, CompactGraph::index_t b)
+		{
+			return m_centrality[a] > m_centrality[b];
+		}
+	);
+
+	m_centrality_rows.resize(top);
+	for (size_t rank = 0; rank < top; rank++)
+		m_centrality_rows[rank] = { rank + 1, order[rank] };
+}
+
+std::vector<double> Analyzer::getWarmStart(const ObjectGraph& graph) const
+{
+	if (m_warm_start_scores.empty())
+		return {};
+
+	// New nodes start from the average score
+	double average = 0;
+	for (const auto& [node, score]: m_warm_start_scores)
+		average += score;
+
+	average /= m_warm_start_scores.size();
+
+	std::vector<double> start(graph.getNodeCount(), average);
+	for (CompactGraph::index_t node = 0; node < start.size(); node++)
+	{
+		auto iter = m_warm_start_scores.find(graph.getNodeObject(node)->getID());
+		if (iter != m_warm_start_scores.end())
+			start[node] = iter->second;
+	}
+
+	return start;
+}
+
+void Analyzer::showCentralityTable()
+{
+	// Node indices refer to the snapshot the scores were computed on, which
+	// keeps the nodes deleted since then alive
+	if (!m_centrality_graph)
+		return;
+
+	const auto& graph = *m_centrality_graph;
+	if (!m_object_manager.isCurrent(graph))
+		ImGui::TextDisabled("Computed before the last changes to the graph");
+
+	if (
+		ImGui::BeginTable(
+			"table_centrality",
+			3,
+			ImGuiTableFlags_ScrollY   |
+			ImGuiTableFlags_Borders   |
+			ImGuiTableFlags_Resizable |
+			ImGuiTableFlags_Sortable
+		)
+	)
+	{
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("Rank", ImGuiTableColumnFlags_DefaultSort);
+		ImGui::TableSetupColumn("Node");
+		ImGui::TableSetupColumn("Score", ImGuiTableColumnFlags_PreferSortDescending);
+		ImGui::TableHeadersRow();
+
+		if (auto* specs = ImGui::TableGetSortSpecs(); specs && specs->SpecsCount && specs->SpecsDirty)
+		{
+			const auto& spec = specs->Specs[0];
+
+			// Rank and score orders coincide, only the node labels need comparing
+			auto key = [&](const CentralityRow& row)
+			{
+				return spec.ColumnIndex == 1
+					? graph.getNodeObject(row.node)->getLabel()
+					: std::string();
+			};
+
+			bool descending_rank = spec.ColumnIndex == 2;
+			std::stable_sort(
+				m_centrality_rows.begin(),
+				m_centrality_rows.end(),
+				[&](const CentralityRow& lhs, const CentralityRow& rhs)
+				{
+					const auto& [a, b] = spec.SortDirection == ImGuiSortDirection_Descending
+						? std::tie(rhs, lhs)
+						: std::tie(lhs, rhs);
+
+					auto key_a = key(a);
+					auto key_b = key(b);
+					if (key_a != key_b)
+						return key_a < key_b;
+
+					return descending_rank
+						? b.rank < a.rank
+						: a.rank < b.rank;
+				}
+			);
+
+			specs->SpecsDirty = false;
+		}
+
+		for (const auto& [rank, node]: m_centrality_rows)
+		{
+			auto label = graph.getNodeObject(node)->getLabel();
+
+			ImGui::TableNextRow();
+
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", rank);
+
+			ImGui::TableNextColumn();
+			ImGui::Text("%.*s", static_cast<int>(label.length()), label.data());
+
+			ImGui::TableNextColumn();
+			ImGui::Text("%g", m_centrality[node]);
+		}
+
+		ImGui::EndTable();
+	}
+}
+
+void Analyzer::applyScores(const ObjectGraph& graph, std::span<const double> node_scores, std::span<const double> edge_scores /*= {}*/)
+{
+	// Scores are usually heavy tailed, the square root keeps the middle visible
+	auto normalizer = [](std::span<const double> scores)
+	{
+		double max = scores.empty()
+			? 0
+			: *std::max_element(scores.begin(), scores.end());
+
+		return [max](double score) -> float
+		{
+			return max > 0
+				? static_cast<float>(std::sqrt(std::max(score, 0.) / max))
+				: 0.f;
+		};
+	};
+
+	auto node_t = normalizer(node_scores);
+	for (CompactGraph::index_t node = 0; node < node_scores.size(); node++)
+	{
+		float t = node_t(node_scores[node]);
+
+		Node* object = graph.getNodeObject(node);
+		object->setRadius(config::node_default_radius * (1 + (config::centrality_max_scale - 1) * t));
+		object->setColor(Interpolate(config::node_default_color, config::centrality_color, t));
+	}
+
+	auto edge_t = normalizer(edge_scores);
+	for (CompactGraph::index_t edge = 0; edge < edge_scores.size(); edge++)
+		graph.getEdgeObject(edge)->setThickness(
+			config::edge_default_thickness * (1 + (config::centrality_max_scale - 1) * edge_t(edge_scores[edge]))
+		);
+}
+
+void Analyzer::showBreadthFirstSearch()
+{
+	// Start from the node the path search was started at, if any
+	if (Node* src = m_object_manager.getPathSrc())
+		m_bfs_source = src->getLabel();
+
+	m_bfs_show = true;
+}
+
+void Analyzer::runBreadthFirstSearch()
+{
+	const auto& graph = m_object_manager.getGraph();
+
+	const auto& nodes = graph.getNodeObjects();
+	auto iter = std::find_if(
+		nodes.begin(),
+		nodes.end(),
+		[&](Node* node)
+		{
+			return node->getLabel() == m_bfs_source;
+		}
+	);
+
+	if (iter == nodes.end())
+	{
+		m_bfs_error = "No node with this label";
+		return;
+	}
+
+	m_bfs_error.clear();
+
+	m_object_manager.runGraphTask(
+		"Breadth-first search",
+		[src = static_cast<CompactGraph::index_t>(iter - nodes.begin())](const ObjectGraph& graph, TaskContext&)
+		{
+			return BreadthFirstSearch(graph, src);
+		},
+		[this](const ObjectGraph& graph, BreadthFirstSearchResult& search, float time)
+		{
+			m_bfs_time = time;
+			m_bfs_level_sizes = std::move(search.level_sizes);
+			m_bfs_bottom_up_levels = search.bottom_up_levels;
+
+			for (CompactGraph::index_t node = 0; node < graph.getNodeCount(); node++)
+				graph.getNodeObject(node)->setColor(
+					search.reached(node)
+						? LevelColor(search.distances[node], m_bfs_level_sizes.size())
+						: config::node_default_color
+				);
+		}
+	);
+}
+
+void Analyzer::resetAppearance()
+{
+	for (auto* node: m_object_manager.findAll<Node>())
+	{
+		node->setColor(config::node_default_color);
+		node->setRadius(config::node_default_radius);
+	}
+
+	for (auto* edge: m_object_manager.findAll<Edge>())
+	{
+		edge->setHighlight(false);
+		edge->setThickness(config::edge_default_thickness);
+	}
+}
+
+void Analyzer::clearHighlight()
+{
+	for (auto* edge: m_object_manager.findAll<Edge>())
+		edge->setHighlight(false);
+}
+
+//========================================
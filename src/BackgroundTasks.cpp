@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <format>
+
+#include <Graph/BackgroundTasks.hpp>
+#include <Graph/ImGuiExtra.hpp>
+#include <Graph/Config.hpp>
+
+//========================================
+
+BackgroundTasks::~BackgroundTasks()
+{
+	cancelAll();
+}
+
+//========================================
+
+bool BackgroundTasks::poll()
+{
+	bool any = false;
+
+	// Completions may start new tasks, the finished ones are taken out first
+	std::vector<std::shared_ptr<Task>> finished;
+	std::erase_if(
+		m_tasks,
+		[&](const std::shared_ptr<Task>& task)
+		{
+			if (!task->finished.load(std::memory_order_acquire))
+				return false;
+
+			finished.push_back(task);
+			return true;
+		}
+	);
+
+	for (auto& task: finished)
+	{
+		if (task->context.isCancelled())
+			continue;
+
+		if (!task->error.empty())
+			m_error = std::format("{}: {}", task->name, task->error);
+
+		else
+			task->complete();
+
+		any = true;
+	}
+
+	return any;
+}
+
+bool BackgroundTasks::isRunning(std::string_view name) const
+{
+	return std::any_of(
+		m_tasks.begin(),
+		m_tasks.end(),
+		[&](const std::shared_ptr<Task>& task)
+		{
+			return task->name == name && !task->context.isCancelled();
+		}
+	);
+}
+
+bool BackgroundTasks::empty() const
+{
+	return m_tasks.empty();
+}
+
+bool BackgroundTasks::hasFinished() const
+{
+	return std::any_of(
+		m_tasks.begin(),
+		m_tasks.end(),
+		[](const std::shared_ptr<Task>& task)
+		{
+			return task->finished.load(std::memory_order_acquire);
+		}
+	);
+}
+
+void BackgroundTasks::cancel(std::string_view name)
+{
+	for (auto& task: m_tasks)
+		if (task->name == name)
+			task->context.cancel();
+}
+
+void BackgroundTasks::cancelAll()
+{
+	for (auto& task: m_tasks)
+		task->context.cancel();
+}
+
+//========================================
+
+void BackgroundTasks::processInterface()
+{
+	if (m_tasks.empty() && m_error.empty())
+		return;
+
+	constexpr auto padding = 10.f;
+	const auto* viewport = ImGui::GetMainViewport();
+
+	ImGui::SetNextWindowBgAlpha(.35f);
+	ImGui::SetNextWindowPos(
+		ImVec2(viewport->WorkPos.x + padding, viewport->WorkPos.y + viewport->WorkSize.y - padding),
+		0,
+		ImVec2(0, 1)
+	);
+
+	if (
+		ImGui::Begin(
+			"Background tasks",
+			nullptr,
+			ImGuiWindowFlags_NoDecoration       |
+			ImGuiWindowFlags_AlwaysAutoResize   |
+			ImGuiWindowFlags_NoSavedSettings    |
+			ImGuiWindowFlags_NoFocusOnAppearing |
+			ImGuiWindowFlags_NoMove
+		)
+	)
+	{
+		for (auto& task: m_tasks)
+		{
+			ImGui::PushID(task.get());
+
+			// Cancelled tasks are only waited for to free their worker
+			if (task->context.isCancelled())
+				ImGui::TextDisabled("%s: cancelling", task->name.c_str());
+
+			else
+			{
+				ImGui::TextUnformatted(task->name.c_str());
+				ImGui::SameLine();
+
+				double progress = task->context.getProgress();
+				ImGui::ProgressBar(
+					progress < 0
+						? -static_cast<float>(ImGui::GetTime())
+						: static_cast<float>(progress),
+					ImVec2(config::task_progress_width, 0),
+					progress < 0
+						? "running"
+						: nullptr
+				);
+
+				ImGui::SameLine();
+				if (ImGui::SmallButton("Cancel"))
+					task->context.cancel();
+			}
+
+			ImGui::PopID();
+		}
+
+		if (!m_error.empty())
+		{
+			ImGui::TextColored(ImVec4(1, .3f, .3f, 1), "%s", m_error.c_str());
+			ImGui::SameLine();
+
+			if (ImGui::SmallButton("Dismiss"))
+				m_error.clear();
+		}
+	}
+
+	ImGui::End();
+}
+
+//========================================
@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include <Graph/GraphData.hpp>
+
+//========================================
+
+namespace
+{
+
+constexpr char     binary_signature[4] = { 'G', 'R', 'P', 'H' };
+constexpr uint32_t binary_version = 2;
+
+// Version 1 files have no edge directions
+constexpr uint32_t binary_version_undirected = 1;
+
+constexpr std::string_view directed_arrow = "->";
+
+template<typename T>
+void Write(std::ostream& stream, const T& value)
+{
+	stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<typename T>
+bool Read(std::istream& stream, T& value)
+{
+	return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+// Counts read from a file are checked against what the rest of it can hold
+// before anything is allocated for them. Takes the records from the bytes
+// that are not accounted for yet
+bool Take(uint64_t& remaining, uint64_t count, uint64_t record_size)
+{
+	if (count > remaining / record_size)
+		return false;
+
+	remaining -= count * record_size;
+	return true;
+}
+
+} // namespace
+
+//========================================
+
+bool GraphData::loadFromFile(const std::filesystem::path& path)
+{
+	std::ifstream stream(path, std::ios::binary);
+	if (!stream)
+		return false;
+
+	clear();
+
+	std::error_code error;
+	uint64_t size = std::filesystem::file_size(path, error);
+	if (error)
+		return false;
+
+	char signature[sizeof(binary_signature)] = {};
+	stream.read(signature, sizeof(signature));
+
+	bool binary = stream.gcount() == sizeof(signature) && std::equal(
+		std::begin(signature), 
+		std::end(signature), 
+		std::begin(binary_signature)
+	);
+
+	if (!binary)
+	{
+		stream.clear();
+		stream.seekg(0);
+	}
+
+	bool result = binary
+		? loadBinary(stream, size - sizeof(signature))
+		: loadText(stream);
+
+	if (!result)
+		clear();
+
+	return result;
+}
+
+bool GraphData::saveToFile(const std::filesystem::path& path) const
+{
+	std::ofstream stream(path, std::ios::binary);
+	if (!stream)
+		return false;
+
+	return path.extension() == ".bin"
+		? saveBinary(stream)
+		: saveText(stream);
+}
+
+//========================================
+
+bool GraphData::hasPositions() const
+{
+	return positions.size() == labels.size();
+}
+
+//========================================
+
+bool GraphData::loadBinary(std::istream& stream, uint64_t size)
+{
+	// Bytes of the file the records read so far do not account for
+	uint64_t remaining = size;
+
+	uint32_t version = 0;
+	uint64_t node_count = 0;
+
+	if (!Take(remaining, 1, sizeof(version) + sizeof(node_count)))
+		return false;
+
+	if (!Read(stream, version) || version < binary_version_undirected || version > binary_version || !Read(stream, node_count))
+		return false;
+
+	// Label length and position of a node with an empty label
+	constexpr uint64_t node_record_size = sizeof(uint32_t) + 2 * sizeof(float);
+	if (!Take(remaining, node_count, node_record_size))
+		return false;
+
+	labels.resize(node_count);
+	positions.resize(node_count);
+
+	for (uint64_t i = 0; i < node_count; i++)
+	{
+		uint32_t length = 0;
+		if (!Read(stream, length))
+			return false;
+
+		if (!Take(remaining, length, 1))
+			return false;
+
+		labels[i].resize(length);
+		if (!stream.read(labels[i].data(), length))
+			return false;
+
+		if (!Read(stream, positions[i].x) || !Read(stream, positions[i].y))
+			return false;
+	}
+
+	uint64_t edge_count = 0;
+	if (!Take(remaining, 1, sizeof(edge_count)) || !Read(stream, edge_count))
+		return false;
+
+	uint64_t edge_record_size = sizeof(CompactGraph::index_t) * 2 + sizeof(int);
+	if (version >= binary_version)
+		edge_record_size += sizeof(uint8_t);
+
+	if (!Take(remaining, edge_count, edge_record_size))
+		return false;
+
+	edges.resize(edge_count);
+	for (auto& edge: edges)
+	{
+		if (!Read(stream, edge.a) || !Read(stream, edge.b) || !Read(stream, edge.weight))
+			return false;
+
+		uint8_t directed = 0;
+		if (version >= binary_version && !Read(stream, directed))
+			return false;
+
+		edge.directed = directed;
+
+		if (edge.a >= node_count || edge.b >= node_count)
+			return false;
+	}
+
+	return true;
+}
+
+bool GraphData::loadText(std::istream& stream)
+{
+	std::unordered_map<std::string, CompactGraph::index_t> indices;
+
+	auto node = [&](const std::string& label) -> CompactGraph::index_t
+	{
+		auto [iter, inserted] = indices.try_emplace(label, static_cast<CompactGraph::index_t>(labels.size()));
+		if (inserted)
+			labels.push_back(label);
+
+		return iter->second;
+	};
+
+	std::string line;
+	while (std::getline(stream, line))
+	{
+		if (auto comment = line.find('#'); comment != std::string::npos)
+			line.erase(comment);
+
+		std::istringstream tokens(line);
+
+		std::string a, b;
+		if (!(tokens >> a))
+			continue;
+
+		if (!(tokens >> b))
+		{
+			node(a);
+			continue;
+		}
+
+		bool directed = b == directed_arrow;
+		if (directed && !(tokens >> b))
+			return false;
+
+		// Edges without an explicit weight count as one
+		int weight = 1;
+		if (!(tokens >> weight) && !tokens.eof())
+			return false;
+
+		edges.push_back({ node(a), node(b), weight, directed });
+	}
+
+	return true;
+}
+
+//========================================
+
+bool GraphData::saveBinary(std::ostream& stream) const
+{
+	stream.write(binary_signature, sizeof(binary_signature));
+	Write(stream, binary_version);
+	Write(stream, static_cast<uint64_t>(labels.size()));
+
+	for (size_t i = 0; i < labels.size(); i++)
+	{
+		Write(stream, static_cast<uint32_t>(labels[i].size()));
+		stream.write(labels[i].data(), labels[i].size());
+
+		auto position = i < positions.size()
+			? positions[i]
+			: sf::Vector2f();
+
+		Write(stream, position.x);
+		Write(stream, position.y);
+	}
+
+	Write(stream, static_cast<uint64_t>(edges.size()));
+	for (const auto& edge: edges)
+	{
+		Write(stream, edge.a);
+		Write(stream, edge.b);
+		Write(stream, edge.weight);
+		Write(stream, static_cast<uint8_t>(edge.directed));
+	}
+
+	return static_cast<bool>(stream);
+}
+
+bool GraphData::saveText(std::ostream& stream) const
+{
+	std::vector<bool> connected(labels.size(), false);
+	for (const auto& edge: edges)
+	{
+		stream << labels[edge.a] << ' ';
+		if (edge.directed)
+			stream << directed_arrow << ' ';
+
+		stream << labels[edge.b] << ' ' << edge.weight << '\n';
+		connected[edge.a] = connected[edge.b] = true;
+	}
+
+	for (size_t i = 0; i < labels.size(); i++)
+		if (!connected[i])
+			stream << labels[i] << '\n';
+
+	return static_cast<bool>(stream);
+}
+
+//========================================
+
+CompactGraph GraphData::buildGraph() const
+{
+	return CompactGraph(labels.size(), edges);
+}
+
+std::optional<CompactGraph::index_t> GraphData::findNode(std::string_view label) const
+{
+	auto iter = std::find(labels.begin(), labels.end(), label);
+	if (iter == labels.end())
+		return std::nullopt;
+
+	return static_cast<CompactGraph::index_t>(iter - labels.begin());
+}
+
+void GraphData::clear()
+{
+	labels.clear();
+	positions.clear();
+	edges.clear();
+}
+
+//========================================
@@ -0,0 +1,764 @@
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <Graph/Headless.hpp>
+#include <Graph/GraphData.hpp>
+#include <Graph/Algorithms/Betweenness.hpp>
+#include <Graph/Algorithms/BreadthFirstSearch.hpp>
+#include <Graph/Algorithms/Centrality.hpp>
+#include <Graph/Algorithms/Coloring.hpp>
+#include <Graph/Algorithms/Communities.hpp>
+#include <Graph/Algorithms/Components.hpp>
+#include <Graph/Algorithms/Generators.hpp>
+#include <Graph/Algorithms/HyperBall.hpp>
+#include <Graph/Algorithms/Layout.hpp>
+#include <Graph/Algorithms/MaxFlow.hpp>
+#include <Graph/Algorithms/ShortestPath.hpp>
+#include <Graph/Algorithms/SpanningTree.hpp>
+#include <Graph/Algorithms/Triangles.hpp>
+
+//========================================
+
+namespace
+{
+
+constexpr std::string_view usage =
+	"Usage: graph --headless [commands...]\n"
+	"\n"
+	"Commands are executed in order:\n"
+	"  --load <file>         load a binary graph or a text edge list\n"
+	"  --save <file>         save the graph, binary if the extension is .bin\n"
+	"  --generate <model>    replace the graph with a random one, model is one of\n"
+	"               gnp <nodes> <probability> <seed>\n"
+	"               gnm <nodes> <edges> <seed>\n"
+	"               ba <nodes> <attachment> <seed>\n"
+	"               ws <nodes> <neighbours> <rewiring> <seed>\n"
+	"               rmat <scale> <edge factor> <seed>\n"
+	"  --output <file>       write the following results to a file instead of stdout\n"
+	"  --info                print the number of nodes and edges\n"
+	"  --layout <method>     compute node positions, method is multilevel or spectral\n"
+	"  --positions           print the position of every node\n"
+	"  --shortest <a> <b>    print the path with the fewest edges between two nodes\n"
+	"  --path <strategy> <a> <b>\n"
+	"                        print the shortest path found with a strategy, which is bfs, dijkstra\n"
+	"                        or bidirectional, and report the search counters to stderr\n"
+	"  --bfs <node>          print the number of nodes at every distance from a node\n"
+	"  --maxflow <a> <b>     print the maximum flow value and the minimum cut edges\n"
+	"  --components          print the sizes of the connected components\n"
+	"  --scc                 print the sizes of the strongly connected components\n"
+	"  --betweenness <k>     print the betweenness of every node, estimated from k sources unless k is 0\n"
+	"  --triangles           print the triangle count and clustering coefficient of every node\n"
+	"  --pagerank <damping>  print the PageRank of every node\n"
+	"  --coloring <order>    print the colour of every node, order is natural, largest-first or smallest-last\n"
+	"  --communities <res>   print the Louvain community of every node at the given resolution\n"
+	"  --hyperball <log2>    print the neighbourhood function, effective diameter and the estimated\n"
+	"                        closeness and harmonic centrality of every node, using 2^log2 registers\n"
+	"  --msf <method>        print the minimum spanning forest, method is auto, boruvka or kruskal\n"
+	"  --help                print this message\n";
+
+// std::stoull accepts a minus sign and wraps the negative number around,
+// which would turn "-1" into a huge count
+uint64_t ParseUnsigned(const std::string& text)
+{
+	auto first = text.find_first_not_of(" \t\n\v\f\r");
+	if (first != std::string::npos && text[first] == '-')
+		throw std::invalid_argument(text);
+
+	return std::stoull(text);
+}
+
+class Session
+{
+public:
+	int run(std::span<char*> args);
+
+private:
+	GraphData m_data {};
+	CompactGraph m_graph {};
+
+	std::ofstream m_file {};
+	std::ostream* m_output = &std::cout;
+
+	bool execute(std::string_view command, std::span<char*>& args);
+
+	// Reports the time a command took to stderr, so that it does not mix with the results
+	template<typename F>
+	bool timed(std::string_view command, F&& function);
+
+	std::optional<CompactGraph::index_t> findNode(std::string_view label);
+
+};
+
+//========================================
+
+int Session::run(std::span<char*> args)
+{
+	if (args.empty())
+	{
+		std::cerr << usage;
+		return 1;
+	}
+
+	while (!args.empty())
+	{
+		std::string_view command = args.front();
+		args = args.subspan(1);
+
+		if (command == "--headless")
+			continue;
+
+		// Numeric arguments are parsed with std::sto*, which throw on malformed input
+		try
+		{
+			if (!execute(command, args))
+				return 1;
+		}
+
+		catch (const std::logic_error&)
+		{
+			std::cerr << std::format("{}: invalid argument\n", command);
+			return 1;
+		}
+
+		catch (const std::exception& exception)
+		{
+			std::cerr << std::format("{}: {}\n", command, exception.what());
+			return 1;
+		}
+	}
+
+	m_output->flush();
+	return 0;
+}
+
+bool Session::execute(std::string_view command, std::span<char*>& args)
+{
+	auto take = [&](size_t count) -> std::span<char*>
+	{
+		if (args.size() < count)
+		{
+			std::cerr << std::format("{}: expected {} argument(s)\n", command, count);
+			return {};
+		}
+
+		auto taken = args.first(count);
+		args = args.subspan(count);
+
+		return taken;
+	};
+
+	if (command == "--help")
+	{
+		std::cout << usage;
+		return true;
+	}
+
+	if (command == "--load")
+	{
+		auto params = take(1);
+		if (params.empty())
+			return false;
+
+		return timed(
+			command,
+			[&]
+			{
+				if (!m_data.loadFromFile(params[0]))
+				{
+					std::cerr << std::format("Failed to load '{}'\n", params[0]);
+					return false;
+				}
+
+				m_graph = m_data.buildGraph();
+				return true;
+			}
+		);
+	}
+
+	if (command == "--save")
+	{
+		auto params = take(1);
+		if (params.empty())
+			return false;
+
+		if (!m_data.saveToFile(params[0]))
+		{
+			std::cerr << std::format("Failed to save '{}'\n", params[0]);
+			return false;
+		}
+
+		return true;
+	}
+
+	if (command == "--generate")
+	{
+		auto params = take(1);
+		if (params.empty())
+			return false;
+
+		std::string_view model = params[0];
+
+		RandomGraphSettings settings;
+		std::span<char*> values;
+
+		if (model == "gnp" && !(values = take(3)).empty())
+		{
+			settings.model       = RandomGraphModel::Gnp;
+			settings.nodes       = ParseUnsigned(values[0]);
+			settings.probability = std::stod(values[1]);
+		}
+
+		else if (model == "gnm" && !(values = take(3)).empty())
+		{
+			settings.model = RandomGraphModel::Gnm;
+			settings.nodes = ParseUnsigned(values[0]);
+			settings.edges = ParseUnsigned(values[1]);
+		}
+
+		else if (model == "ba" && !(values = take(3)).empty())
+		{
+			settings.model      = RandomGraphModel::BarabasiAlbert;
+			settings.nodes      = ParseUnsigned(values[0]);
+			settings.attachment = ParseUnsigned(values[1]);
+		}
+
+		else if (model == "ws" && !(values = take(4)).empty())
+		{
+			settings.model      = RandomGraphModel::WattsStrogatz;
+			settings.nodes      = ParseUnsigned(values[0]);
+			settings.neighbours = ParseUnsigned(values[1]);
+			settings.rewiring   = std::stod(values[2]);
+		}
+
+		else if (model == "rmat" && !(values = take(3)).empty())
+		{
+			settings.model       = RandomGraphModel::RMat;
+			// Clamped before narrowing, so that huge scales stay out of range
+			settings.scale       = static_cast<unsigned>(std::min<uint64_t>(ParseUnsigned(values[0]), rmat_max_scale + 1));
+			settings.edge_factor = ParseUnsigned(values[1]);
+		}
+
+		else
+		{
+			if (values.empty() && (model == "gnp" || model == "gnm" || model == "ba" || model == "ws" || model == "rmat"))
+				return false;
+
+			std::cerr << std::format("Unknown random graph model '{}'\n", model);
+			return false;
+		}
+
+		settings.seed = ParseUnsigned(values.back());
+
+		if (!settings.isValid())
+		{
+			std::cerr << std::format("{}: parameters of '{}' out of range\n", command, model);
+			return false;
+		}
+
+		return timed(
+			command,
+			[&]
+			{
+				m_data.clear();
+				m_data.edges = GenerateRandomGraph(settings);
+
+				m_data.labels.resize(settings.getNodeCount());
+				for (size_t i = 0; i < m_data.labels.size(); i++)
+					m_data.labels[i] = std::to_string(i);
+
+				m_graph = m_data.buildGraph();
+				return true;
+			}
+		);
+	}
+
+	if (command == "--output")
+	{
+		auto params = take(1);
+		if (params.empty())
+			return false;
+
+		m_output->flush();
+		m_file = std::ofstream(params[0]);
+
+		if (!m_file)
+		{
+			std::cerr << std::format("Failed to open '{}'\n", params[0]);
+			return false;
+		}
+
+		m_output = &m_file;
+		return true;
+	}
+
+	if (command == "--info")
+	{
+		*m_output << std::format("nodes {}\nedges {}\n", m_graph.getNodeCount(), m_graph.getEdgeCount());
+		return true;
+	}
+
+	if (command == "--layout")
+	{
+		auto params = take(1);
+		if (params.empty())
+			return false;
+
+		std::string_view method = params[0];
+		return timed(
+			command,
+			[&]
+			{
+				if (method == "multilevel")
+					m_data.positions = MultilevelLayout(m_graph);
+
+				else if (method == "spectral")
+					m_data.positions = SpectralLayout(m_graph);
+
+				else
+				{
+					std::cerr << std::format("Unknown layout method '{}'\n", method);
+					return false;
+				}
+
+				return true;
+			}
+		);
+	}
+
+	if (command == "--positions")
+	{
+		if (!m_data.hasPositions())
+		{
+			std::cerr << "The graph has no node positions, compute them with --layout\n";
+			return false;
+		}
+
+		for (size_t i = 0; i < m_data.labels.size(); i++)
+			*m_output << std::format("{} {} {}\n", m_data.labels[i], m_data.positions[i].x, m_data.positions[i].y);
+
+		return true;
+	}
+
+	if (command == "--shortest" || command == "--path")
+	{
+		// --shortest is the breadth-first search without the counters
+		auto strategy = PathStrategy::BreadthFirst;
+		if (command == "--path")
+		{
+			auto params = take(1);
+			if (params.empty())
+				return false;
+
+			std::string_view name = params[0];
+			if (name == "bfs")
+				strategy = PathStrategy::BreadthFirst;
+
+			else if (name == "dijkstra")
+				strategy = PathStrategy::Dijkstra;
+
+			else if (name == "bidirectional")
+				strategy = PathStrategy::BidirectionalDijkstra;
+
+			else
+			{
+				std::cerr << std::format("Unknown path strategy '{}'\n", name);
+				return false;
+			}
+		}
+
+		auto params = take(2);
+		if (params.empty())
+			return false;
+
+		auto src = findNode(params[0]);
+		auto dst = findNode(params[1]);
+
+		if (!src || !dst)
+			return false;
+
+		return timed(
+			command,
+			[&]
+			{
+				auto path = ShortestPath(m_graph, *src, *dst, strategy);
+				if (command == "--path")
+					std::cerr << std::format(
+						"--path: {:.3f} ms, settled {}, relaxed {}, pushes {}, pops {}, peak frontier {}\n",
+						path.stats.time,
+						path.stats.settled,
+						path.stats.relaxed,
+						path.stats.pushes,
+						path.stats.pops,
+						path.stats.peak_frontier
+					);
+
+				if (path.empty())
+				{
+					*m_output << "unreachable\n";
+					return true;
+				}
+
+				for (size_t i = 0; i < path.nodes.size(); i++)
+					*m_output << std::format("{}{}", m_data.labels[path.nodes[i]], i + 1 < path.nodes.size() ? " -> " : "\n");
+
+				*m_output << std::format("length {}\nweight {}\n", path.edges.size(), path.getWeight(m_graph));
+				return true;
+			}
+		);
+	}
+
+	if (command == "--bfs")
+	{
+		auto params = take(1);
+		if (params.empty())
+			return false;
+
+		auto src = findNode(params[0]);
+		if (!src)
+			return false;
+
+		return timed(
+			command,
+			[&]
+			{
+				auto search = BreadthFirstSearch(m_graph, *src);
+
+				*m_output << std::format("reached {}\nlevels {}\n", search.getReachedCount(), search.level_sizes.size());
+				for (size_t i = 0; i < search.level_sizes.size(); i++)
+					*m_output << std::format("{} {}\n", i, search.level_sizes[i]);
+
+				return true;
+			}
+		);
+	}
+
+	if (command == "--maxflow")
+	{
+		auto params = take(2);
+		if (params.empty())
+			return false;
+
+		auto src = findNode(params[0]);
+		auto dst = findNode(params[1]);
+
+		if (!src || !dst)
+			return false;
+
+		return timed(
+			command,
+			[&]
+			{
+				auto flow = MaximumFlow(m_graph, *src, *dst);
+
+				*m_output << std::format("value {}\ncut {}\n", flow.value, flow.cut_edges.size());
+				for (auto edge: flow.cut_edges)
+				{
+					const auto& record = m_graph.getEdge(edge);
+					*m_output << std::format("{} {} {}\n", m_data.labels[record.a], m_data.labels[record.b], record.weight);
+				}
+
+				std::cerr << std::format(
+					"--maxflow: init {:.1f} ms, discharge {:.1f} ms, global relabel {:.1f} ms, cut {:.1f} ms\n",
+					flow.init_time,
+					flow.discharge_time,
+					flow.global_relabel_time,
+					flow.cut_time
+				);
+
+				return true;
+			}
+		);
+	}
+
+	if (command == "--components")
+	{
+		return timed(
+			command,
+			[&]
+			{
+				auto components = ConnectedComponents(m_graph);
+
+				*m_output << std::format("components {}\n", components.getCount());
+				for (size_t i = 0; i < components.getCount(); i++)
+					*m_output << std::format("{} {}\n", i, components.sizes[i]);
+
+				return true;
+			}
+		);
+	}
+
+	if (command == "--scc")
+	{
+		return timed(
+			command,
+			[&]
+			{
+				auto components = StronglyConnectedComponents(m_graph);
+
+				*m_output << std::format("strong components {}\n", components.getCount());
+				for (size_t i = 0; i < components.getCount(); i++)
+					*m_output << std::format("{} {}\n", i, components.sizes[i]);
+
+				return true;
+			}
+		);
+	}
+
+	if (command == "--betweenness")
+	{
+		auto params = take(1);
+		if (params.empty())
+			return false;
+
+		BetweennessSettings settings;
+		settings.samples = ParseUnsigned(params[0]);
+
+		return timed(
+			command,
+			[&]
+			{
+				auto betweenness = BetweennessCentrality(m_graph, settings);
+				for (size_t i = 0; i < betweenness.nodes.size(); i++)
+					*m_output << std::format("{} {}\n", m_data.labels[i], betweenness.nodes[i]);
+
+				return true;
+			}
+		);
+	}
+
+	if (command == "--triangles")
+	{
+		return timed(
+			command,
+			[&]
+			{
+				auto triangles = CountTriangles(m_graph);
+
+				*m_output << std::format(
+					"triangles {} transitivity {} average_clustering {}\n",
+					triangles.total,
+					triangles.transitivity,
+					triangles.average_clustering
+				);
+
+				for (size_t i = 0; i < triangles.nodes.size(); i++)
+					*m_output << std::format("{} {} {}\n", m_data.labels[i], triangles.nodes[i], triangles.clustering[i]);
+
+				return true;
+			}
+		);
+	}
+
+	if (command == "--pagerank")
+	{
+		auto params = take(1);
+		if (params.empty())
+			return false;
+
+		PowerIterationSettings settings;
+		settings.damping = std::stod(params[0]);
+
+		if (settings.damping < pagerank_min_damping || settings.damping > pagerank_max_damping)
+		{
+			std::cerr << std::format("{}: damping must be in [{}, {}]\n", command, pagerank_min_damping, pagerank_max_damping);
+			return false;
+		}
+
+		return timed(
+			command,
+			[&]
+			{
+				auto pagerank = PageRank(m_graph, settings);
+
+				*m_output << std::format("iterations {} residual {}\n", pagerank.iterations, pagerank.residual);
+				for (size_t i = 0; i < pagerank.scores.size(); i++)
+					*m_output << std::format("{} {}\n", m_data.labels[i], pagerank.scores[i]);
+
+				return true;
+			}
+		);
+	}
+
+	if (command == "--coloring")
+	{
+		auto params = take(1);
+		if (params.empty())
+			return false;
+
+		std::string_view name = params[0];
+
+		ColoringOrder order;
+		if (name == "natural")
+			order = ColoringOrder::Natural;
+
+		else if (name == "largest-first")
+			order = ColoringOrder::LargestFirst;
+
+		else if (name == "smallest-last")
+			order = ColoringOrder::SmallestLast;
+
+		else
+		{
+			std::cerr << std::format("Unknown colouring order '{}'\n", name);
+			return false;
+		}
+
+		return timed(
+			command,
+			[&]
+			{
+				auto coloring = GreedyColoring(m_graph, order);
+
+				*m_output << std::format("colors {} rounds {} conflicts {}\n", coloring.getCount(), coloring.rounds, coloring.conflicts);
+				for (size_t i = 0; i < coloring.colors.size(); i++)
+					*m_output << std::format("{} {}\n", m_data.labels[i], coloring.colors[i]);
+
+				return true;
+			}
+		);
+	}
+
+	if (command == "--communities")
+	{
+		auto params = take(1);
+		if (params.empty())
+			return false;
+
+		LouvainSettings settings;
+		settings.resolution = std::stod(params[0]);
+
+		if (settings.resolution <= 0)
+		{
+			std::cerr << std::format("{}: resolution must be positive\n", command);
+			return false;
+		}
+
+		return timed(
+			command,
+			[&]
+			{
+				auto communities = LouvainCommunities(m_graph, settings);
+
+				*m_output << std::format("communities {} modularity {}\n", communities.getCount(), communities.modularity);
+				for (size_t i = 0; i < communities.levels.size(); i++)
+					*m_output << std::format("level {} {} {}\n", i + 1, communities.levels[i].communities, communities.levels[i].modularity);
+
+				for (size_t i = 0; i < communities.labels.size(); i++)
+					*m_output << std::format("{} {}\n", m_data.labels[i], communities.labels[i]);
+
+				return true;
+			}
+		);
+	}
+
+	if (command == "--hyperball")
+	{
+		auto params = take(1);
+		if (params.empty())
+			return false;
+
+		HyperBallSettings settings;
+		settings.log2_registers = static_cast<unsigned>(ParseUnsigned(params[0]));
+
+		return timed(
+			command,
+			[&]
+			{
+				auto hyperball = HyperBall(m_graph, settings);
+
+				*m_output << std::format("effective_diameter {}\n", hyperball.getEffectiveDiameter());
+				for (size_t t = 0; t < hyperball.neighbourhood.size(); t++)
+					*m_output << std::format("N {} {}\n", t, hyperball.neighbourhood[t]);
+
+				for (size_t i = 0; i < hyperball.closeness.size(); i++)
+					*m_output << std::format("{} {} {}\n", m_data.labels[i], hyperball.closeness[i], hyperball.harmonic[i]);
+
+				return true;
+			}
+		);
+	}
+
+	if (command == "--msf")
+	{
+		auto params = take(1);
+		if (params.empty())
+			return false;
+
+		std::string_view name = params[0];
+
+		SpanningForestMethod method;
+		if (name == "auto")
+			method = SpanningForestMethod::Automatic;
+
+		else if (name == "boruvka")
+			method = SpanningForestMethod::Boruvka;
+
+		else if (name == "kruskal")
+			method = SpanningForestMethod::Kruskal;
+
+		else
+		{
+			std::cerr << std::format("Unknown spanning forest method '{}'\n", name);
+			return false;
+		}
+
+		return timed(
+			command,
+			[&]
+			{
+				auto forest = MinimumSpanningForest(m_graph, method);
+
+				*m_output << std::format("weight {}\nedges {}\ntrees {}\n", forest.weight, forest.edges.size(), forest.trees);
+				for (auto edge: forest.edges)
+				{
+					const auto& record = m_graph.getEdge(edge);
+					*m_output << std::format("{} {} {}\n", m_data.labels[record.a], m_data.labels[record.b], record.weight);
+				}
+
+				return true;
+			}
+		);
+	}
+
+	std::cerr << std::format("Unknown command '{}'\n\n{}", command, usage);
+	return false;
+}
+
+template<typename F>
+bool Session::timed(std::string_view command, F&& function)
+{
+	auto start = std::chrono::steady_clock::now();
+	bool result = function();
+
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	std::cerr << std::format("{}: {:.1f} ms\n", command, elapsed.count());
+
+	return result;
+}
+
+std::optional<CompactGraph::index_t> Session::findNode(std::string_view label)
+{
+	auto node = m_data.findNode(label);
+	if (!node)
+		std::cerr << std::format("No node labeled '{}'\n", label);
+
+	return node;
+}
+
+} // namespace
+
+//========================================
+
+int RunHeadless(int argc, char** argv)
+{
+	Session session;
+	return session.run(std::span(argv + 1, argc - 1));
+}
+
+//========================================
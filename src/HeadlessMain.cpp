@@ -0,0 +1,10 @@
+#include <Graph/Headless.hpp>
+
+//========================================
+
+int main(int argc, char** argv)
+{
+	return RunHeadless(argc, argv);
+}
+
+//========================================
@@ -9,7 +9,12 @@
 #include <SFML/Graphics.hpp>
 
 #include <Graph/Objects/ObjectManager.hpp>
+#include <Graph/Objects/ObjectGraph.hpp>
+#include <Graph/Algorithms/Generators.hpp>
+#include <Graph/Algorithms/Layout.hpp>
 
+#include <Graph/Analyzer.hpp>
+#include <Graph/Headless.hpp>
 #include <Graph/ImmersiveDarkMode.hpp>
 #include <Graph/ImGuiExtra.hpp>
 #include <Graph/Config.hpp>
@@ -27,9 +32,18 @@ public:
 private:
 	sf::RenderWindow m_render_window {};
 	ObjectManager m_object_manager {};
+	Analyzer m_analyzer { m_object_manager };
 
 	sf::Clock m_delta_clock {};
 
+	// Frames are only drawn when something may have changed, the rest of
+	// the time the loop sleeps until the next event
+	bool m_render_on_demand = true;
+	unsigned m_settle_frames = 0;
+
+	Profiler m_profiler {};
+	bool m_profiler_show = false;
+
 	sf::Font m_font {};
 	sf::Cursor m_default_cursor {};
 	sf::Cursor m_drag_cursor {};
@@ -52,6 +66,14 @@ private:
 	std::vector<std::string> m_incidence_matrix_rows {};
 	std::vector<bool>        m_incidence_matrix_cells   {};
 
+	bool m_file_dialog_show = false;
+	bool m_file_dialog_save = false;
+	std::string m_file_path {};
+	std::string m_file_error {};
+
+	RandomGraphSettings m_random_graph_settings {};
+	size_t m_grid_size[2] = { 5, 5 };
+
 	sf::RectangleShape m_background_rect;
 	sf::Shader m_background_shader;
 	bool m_show_background_dots = true;
@@ -59,13 +81,24 @@ private:
 	void onEvent(const sf::Event& event);
 	void processInterface();
 
+	// Whether the next frame may look different from the last one
+	bool needsRedraw() const;
+
+	// Handles the first event to arrive, or returns after a timeout or once a
+	// background task has finished, whichever comes first
+	void waitForChange();
+
 	void showAdjacencyMatrix();
 	void showIncidenceMatrix();
+	void showFileDialog(bool save);
 
 	void generateRandomGraph();
 	void generateGridGraph();
 	void generateCircularGraph();
 
+	bool showRandomGraphSettings();
+	void generateRandomModelGraph();
+
 };
 
 //======================================== Main loop
@@ -79,6 +112,7 @@ void Main::run()
 		return;
 
 	m_object_manager.setFont(&m_font);
+	m_object_manager.setProfiler(&m_profiler);
 
 	m_drag_cursor.loadFromSystem(sf::Cursor::SizeAll);
 	m_default_cursor.loadFromSystem(sf::Cursor::Arrow);
@@ -119,26 +153,114 @@ void Main::run()
 
 	while (m_render_window.isOpen())
 	{
-		sf::Event event;
-		while (m_render_window.pollEvent(event))
-			onEvent(event);
+		// Idle time is left out of the profiled frames
+		if (!needsRedraw())
+			waitForChange();
+
+		if (m_settle_frames)
+			m_settle_frames--;
+
+		m_profiler.beginFrame();
 
-		m_render_window.clear() ;
+		{
+			ProfileScope scope(&m_profiler, "Events");
+
+			sf::Event event;
+			while (m_render_window.pollEvent(event))
+				onEvent(event);
+		}
 
-		m_background_rect.setSize(sf::Vector2f(m_render_window.getSize()));
-		m_background_rect.setPosition(sf::Vector2(m_render_window.mapPixelToCoords(sf::Vector2i(0, 0))));
+		// Results of the finished algorithms, once the deleted objects are gone
+		{
+			ProfileScope scope(&m_profiler, "Tasks");
+			if (m_object_manager.getTasks().poll())
+				m_settle_frames = config::idle_settle_frames;
+		}
 
-		m_background_shader.setUniform("enable", m_show_background_dots);
-		m_background_shader.setUniform("center", m_render_window.getView().getCenter());
-		m_render_window.draw(m_background_rect, &m_background_shader);
+		{
+			ProfileScope scope(&m_profiler, "Background");
 
-		processInterface();
-		m_object_manager.drawObjects();
+			m_render_window.clear();
 
-		ImGui::SFML::Render(m_render_window);
+			m_background_rect.setSize(sf::Vector2f(m_render_window.getSize()));
+			m_background_rect.setPosition(sf::Vector2(m_render_window.mapPixelToCoords(sf::Vector2i(0, 0))));
+
+			m_background_shader.setUniform("enable", m_show_background_dots);
+			m_background_shader.setUniform("center", m_render_window.getView().getCenter());
+			m_render_window.draw(m_background_rect, &m_background_shader);
+		}
+
+		{
+			ProfileScope scope(&m_profiler, "Interface");
+			processInterface();
+		}
 
-		m_render_window.display();
-		m_object_manager.cleanup();
+		{
+			ProfileScope scope(&m_profiler, "Update");
+			m_object_manager.update();
+			m_analyzer.update();
+		}
+
+		{
+			ProfileScope scope(&m_profiler, "Objects");
+			m_object_manager.drawObjects();
+		}
+
+		{
+			ProfileScope scope(&m_profiler, "ImGui render");
+			ImGui::SFML::Render(m_render_window);
+		}
+
+		// Includes the wait for the vertical sync
+		{
+			ProfileScope scope(&m_profiler, "Display");
+			m_render_window.display();
+		}
+
+		{
+			ProfileScope scope(&m_profiler, "Cleanup");
+			m_object_manager.cleanup();
+		}
+
+		m_profiler.endFrame();
+	}
+}
+
+bool Main::needsRedraw() const
+{
+	return
+		!m_render_on_demand             ||
+		m_settle_frames                 ||
+		m_object_manager.isAnimating()  ||
+		m_analyzer.isAnimating();
+}
+
+void Main::waitForChange()
+{
+	// SFML 2 can only wait for events without a timeout, so the queue is polled
+	// at a short interval instead, which keeps the idle loop well under a
+	// percent of a core. Progress bars of the running tasks are refreshed
+	// more often than the rest of the interface
+	auto timeout = sf::seconds(
+		m_object_manager.getTasks().empty()
+			? config::idle_timeout
+			: config::idle_task_timeout
+	);
+
+	sf::Clock clock;
+	while (clock.getElapsedTime() < timeout)
+	{
+		sf::Event event;
+		if (m_render_window.pollEvent(event))
+		{
+			onEvent(event);
+			return;
+		}
+
+		if (m_object_manager.getTasks().hasFinished())
+			return;
+
+		sf::sleep(sf::seconds(config::idle_poll_interval));
 	}
 }
 
@@ -157,6 +279,12 @@ void Main::processInterface()
 			// ImGui::MenuItem("Objects",    nullptr, &m_objects_show   );
 			ImGui::MenuItem("Show background dots", nullptr, &m_show_background_dots);
 			ImGui::MenuItem("Imgui demo",           nullptr, &m_imgui_demo_show     );
+			ImGui::MenuItem("Profiler",             nullptr, &m_profiler_show       );
+			ImGui::MenuItem("Render on demand",     nullptr, &m_render_on_demand    );
+
+			bool tiled = m_object_manager.isTiledRendering();
+			if (ImGui::MenuItem("Tiled rendering", nullptr, &tiled))
+				m_object_manager.setTiledRendering(tiled);
 
 			if (ImGui::MenuItem("Reset camera"))
 				m_render_window.setView(
@@ -173,6 +301,12 @@ void Main::processInterface()
 
 		if (ImGui::BeginMenu("Graph"))
 		{
+			if (ImGui::MenuItem("Open..."))
+				showFileDialog(false);
+
+			if (ImGui::MenuItem("Save..."))
+				showFileDialog(true);
+
 			if (ImGui::MenuItem("Clear"))
 				m_object_manager.clear();
 
@@ -182,6 +316,57 @@ void Main::processInterface()
 			if (ImGui::MenuItem("Incidence matrix"))
 				showIncidenceMatrix();
 
+			if (ImGui::MenuItem("Minimum spanning forest"))
+				m_analyzer.findSpanningForest();
+
+			if (ImGui::MenuItem("Communities"))
+				m_analyzer.findCommunities();
+
+			if (ImGui::BeginMenu("Layout"))
+			{
+				if (ImGui::MenuItem("Multilevel"))
+					m_object_manager.runGraphTask(
+						"Layout",
+						[](const ObjectGraph& graph, TaskContext&)
+						{
+							MultilevelLayoutSettings settings;
+							settings.edge_length = config::layout_edge_length;
+
+							return MultilevelLayout(graph, settings);
+						},
+						[this](const ObjectGraph& graph, std::vector<sf::Vector2f>& positions, float)
+						{
+							if (m_object_manager.isCurrent(graph))
+								m_object_manager.applyLayout(graph, positions);
+						}
+					);
+
+				if (ImGui::MenuItem("Spectral"))
+					m_object_manager.runGraphTask(
+						"Layout",
+						[](const ObjectGraph& graph, TaskContext&)
+						{
+							SpectralLayoutSettings settings;
+							settings.edge_length = config::layout_edge_length;
+
+							return SpectralLayout(graph, settings);
+						},
+						[this](const ObjectGraph& graph, std::vector<sf::Vector2f>& positions, float)
+						{
+							if (m_object_manager.isCurrent(graph))
+								m_object_manager.applyLayout(graph, positions, false);
+						}
+					);
+
+				ImGui::EndMenu();
+			}
+
+			ImGui::EndMenu();
+		}
+
+		if (ImGui::BeginMenu("Analysis"))
+		{
+			m_analyzer.showMenu();
 			ImGui::EndMenu();
 		}
 
@@ -220,10 +405,21 @@ void Main::processInterface()
 					m_rmb_menu_show = false;
 				}
 
-				if (ImGui::MenuItem("Grid"))
+				if (ImGui::BeginMenu("Grid"))
 				{
-					generateGridGraph();
-					m_rmb_menu_show = false;
+					ImGui::InputScalar("Columns", ImGuiDataType_U64, &m_grid_size[0]);
+					ImGui::InputScalar("Rows",    ImGuiDataType_U64, &m_grid_size[1]);
+
+					for (auto& side: m_grid_size)
+						side = std::clamp<size_t>(side, 2, config::generator_max_grid_side);
+
+					if (ImGui::Button("Generate"))
+					{
+						generateGridGraph();
+						m_rmb_menu_show = false;
+					}
+
+					ImGui::EndMenu();
 				}
 
 				if (ImGui::MenuItem("Circular"))
@@ -232,6 +428,17 @@ void Main::processInterface()
 					m_rmb_menu_show = false;
 				}
 
+				if (ImGui::BeginMenu("Random model"))
+				{
+					if (showRandomGraphSettings())
+					{
+						generateRandomModelGraph();
+						m_rmb_menu_show = false;
+					}
+
+					ImGui::EndMenu();
+				}
+
 				ImGui::EndMenu();
 			}
 
@@ -239,10 +446,15 @@ void Main::processInterface()
 		}
 	}
 
+	m_analyzer.processInterface();
+
 	// ImGui demo
 	if (m_imgui_demo_show)
 		ImGui::ShowDemoWindow(&m_imgui_demo_show);
 
+	if (m_profiler_show)
+		m_profiler.showWindow(&m_profiler_show);
+
 	/*
 	// Objects
 	if (m_objects_show)
@@ -343,6 +555,40 @@ void Main::processInterface()
 		ImGui::End();
 	}
 
+	// Open/save dialog
+	if (m_file_dialog_show)
+	{
+		if (
+			ImGui::Begin(
+				m_file_dialog_save ? "Save graph" : "Open graph", 
+				&m_file_dialog_show, 
+				ImGuiWindowFlags_AlwaysAutoResize
+			)
+		)
+		{
+			ImGui::Text("Binary when the extension is .bin, text edge list otherwise");
+			ImGui::InputText("Path", &m_file_path);
+
+			if (ImGui::Button(m_file_dialog_save ? "Save" : "Open"))
+			{
+				bool success = m_file_dialog_save
+					? m_object_manager.saveToFile(m_file_path)
+					: m_object_manager.loadFromFile(m_file_path);
+
+				if (success)
+					m_file_dialog_show = false;
+
+				else
+					m_file_error = std::format("Failed to {} '{}'", m_file_dialog_save ? "save" : "open", m_file_path);
+			}
+
+			if (!m_file_error.empty())
+				ImGui::Text("%s", m_file_error.c_str());
+		}
+
+		ImGui::End();
+	}
+
 	// Incidence matrix
 	if (m_incidence_matrix_show)
 	{
@@ -421,9 +667,10 @@ void Main::showAdjacencyMatrix()
 
 	for (size_t i = 0; i < m_adjacency_matrix_cells.size(); i++)
 	{
-		Edge* edge = nodes[i % nodes.size()]->isAdjacent(nodes[i / nodes.size()]);
+		Node* row = nodes[i / nodes.size()];
+		Edge* edge = nodes[i % nodes.size()]->isAdjacent(row);
 
-		m_adjacency_matrix_cells[i] = edge
+		m_adjacency_matrix_cells[i] = edge && edge->leadsFrom(row)
 			? edge->getWeight()
 			: 0;
 	}
@@ -454,10 +701,18 @@ void Main::showIncidenceMatrix()
 	m_incidence_matrix_show = true;
 }
 
+void Main::showFileDialog(bool save)
+{
+	m_file_dialog_save = save;
+	m_file_error.clear();
+	m_file_dialog_show = true;
+}
+
 //======================================== Event processing
 
 void Main::onEvent(const sf::Event& event)
 {
+	m_settle_frames = config::idle_settle_frames;
 	ImGui::SFML::ProcessEvent(m_render_window, event);
 
 	if (m_object_manager.onEvent(event))
@@ -689,55 +944,43 @@ void Main::generateRandomGraph()
 
 void Main::generateGridGraph()
 {
-	constexpr int    padding = 100;
-	constexpr size_t side    = 5;
+	constexpr int padding = 100;
 
+	auto [columns, rows] = m_grid_size;
 	auto size = m_render_window.getSize();
 
-	std::vector<Node*> nodes;
-	for (size_t x = 0; x < side; x++)
-	{
-		for (size_t y = 0; y < side; y++)
-		{
-			Node* node = m_object_manager += new Node;
-			nodes.push_back(node);
-			node->setPosition(
-				m_render_window.mapPixelToCoords(
-					sf::Vector2i(
-						padding + (static_cast<float>(size.x - 2 * padding) / (side - 1)) * x,
-						padding + (static_cast<float>(size.y - 2 * padding) / (side - 1)) * y
-					)
-				)
-			);
-		}
-	}
+	// Fit small grids into the window, keep the nodes apart on large ones
+	sf::Vector2f spacing(
+		std::max(static_cast<float>(size.x - 2 * padding) / (columns - 1), 2 * config::node_default_radius),
+		std::max(static_cast<float>(size.y - 2 * padding) / (rows    - 1), 2 * config::node_default_radius)
+	);
+
+	auto origin = m_render_window.mapPixelToCoords(sf::Vector2i(padding, padding));
 
-	auto get_node = [&](size_t x, size_t y) -> Node*
+	std::vector<CompactGraph::EdgeRecord> edges;
+	edges.reserve(2 * columns * rows);
+
+	auto index = [&](size_t x, size_t y) -> CompactGraph::index_t
 	{
-		return nodes[y * side + x];
+		return static_cast<CompactGraph::index_t>(y * columns + x);
 	};
 
-	for (size_t x = 0; x < side; x++)
+	for (size_t y = 0; y < rows; y++)
 	{
-		for (size_t y = 0; y < side; y++)
+		for (size_t x = 0; x < columns; x++)
 		{
-			Node* node = get_node(x, y);
-
-			if (x < side - 1)
-			{
-				Edge* edge = m_object_manager += new Edge;
-				edge->setNodeA(node);
-				edge->setNodeB(get_node(x + 1, y));
-			}
+			if (x < columns - 1)
+				edges.push_back({ index(x, y), index(x + 1, y), config::edge_default_weight });
 
-			if (y < side - 1)
-			{
-				Edge* edge = m_object_manager += new Edge;
-				edge->setNodeA(node);
-				edge->setNodeB(get_node(x, y + 1));
-			}
+			if (y < rows - 1)
+				edges.push_back({ index(x, y), index(x, y + 1), config::edge_default_weight });
 		}
 	}
+
+	auto nodes = m_object_manager.addGraph(columns * rows, edges);
+	for (size_t y = 0; y < rows; y++)
+		for (size_t x = 0; x < columns; x++)
+			nodes[index(x, y)]->setPosition(origin + sf::Vector2f(spacing.x * x, spacing.y * y));
 }
 
 void Main::generateCircularGraph()
@@ -749,33 +992,126 @@ void Main::generateCircularGraph()
 	auto center = sf::Vector2f(window_size) * .5f;
 	float radius = std::min(window_size.x, window_size.y) / 2 - padding;
 
-	std::vector<Node*> nodes;
+	std::vector<CompactGraph::EdgeRecord> edges;
 	for (size_t i = 0; i < node_count; i++)
-	{
-		Node* node = m_object_manager += new Node;
+		edges.push_back({
+			static_cast<CompactGraph::index_t>(i),
+			static_cast<CompactGraph::index_t>((i + 1) % node_count),
+			config::edge_default_weight
+		});
 
+	auto nodes = m_object_manager.addGraph(node_count, edges);
+	for (size_t i = 0; i < node_count; i++)
+	{
 		float angle = (2 * std::numbers::pi / node_count) * i;
-		node->setPosition(
+		nodes[i]->setPosition(
 			m_render_window.mapPixelToCoords(
 				sf::Vector2i(center + radius * sf::Vector2f(cos(angle), sin(angle)))
 			)
 		);
-
-		nodes.push_back(node);
 	}
+}
 
-	for (size_t i = 0; i < node_count; i++)
+// Returns true when the generate button was pressed
+bool Main::showRandomGraphSettings()
+{
+	static const char* models[] = {
+		"G(n, p)",
+		"G(n, m)",
+		"Barabási–Albert",
+		"Watts–Strogatz",
+		"R-MAT"
+	};
+
+	auto& settings = m_random_graph_settings;
+
+	int model = static_cast<int>(settings.model);
+	if (ImGui::Combo("Model", &model, models, std::size(models)))
+		settings.model = static_cast<RandomGraphModel>(model);
+
+	if (settings.model != RandomGraphModel::RMat)
+		ImGui::InputScalar("Nodes", ImGuiDataType_U64, &settings.nodes);
+
+	switch (settings.model)
 	{
-		Edge* edge = m_object_manager += new Edge;
-		edge->setNodeA(nodes[i]);
-		edge->setNodeB(nodes[(i + 1) % node_count]);
+		case RandomGraphModel::Gnp:
+			ImGui::InputDouble("Probability", &settings.probability, 0, 0, "%g");
+			break;
+
+		case RandomGraphModel::Gnm:
+			ImGui::InputScalar("Edges", ImGuiDataType_U64, &settings.edges);
+			break;
+
+		case RandomGraphModel::BarabasiAlbert:
+			ImGui::InputScalar("Attachment", ImGuiDataType_U64, &settings.attachment);
+			break;
+
+		case RandomGraphModel::WattsStrogatz:
+			ImGui::InputScalar("Neighbours", ImGuiDataType_U64, &settings.neighbours);
+			ImGui::InputDouble("Rewiring", &settings.rewiring, 0, 0, "%g");
+			break;
+
+		case RandomGraphModel::RMat:
+		{
+			ImGui::SliderScalar("Scale", ImGuiDataType_U32, &settings.scale, &config::rmat_scale_min, &config::rmat_scale_max);
+			ImGui::InputScalar("Edge factor", ImGuiDataType_U64, &settings.edge_factor);
+			ImGui::InputDouble("a", &settings.a, 0, 0, "%g");
+			ImGui::InputDouble("b", &settings.b, 0, 0, "%g");
+			ImGui::InputDouble("c", &settings.c, 0, 0, "%g");
+			break;
+		}
 	}
+
+	ImGui::InputScalar("Seed", ImGuiDataType_U64, &settings.seed);
+
+	settings.nodes       = std::clamp<size_t>(settings.nodes, 1, config::generator_max_nodes);
+	settings.probability = std::clamp(settings.probability, 0., 1.);
+	settings.rewiring    = std::clamp(settings.rewiring, 0., 1.);
+
+	// The slider takes typed values beyond its range
+	settings.scale = std::clamp(settings.scale, config::rmat_scale_min, config::rmat_scale_max);
+	settings.a     = std::clamp(settings.a, 0., 1.);
+	settings.b     = std::clamp(settings.b, 0., 1.);
+	settings.c     = std::clamp(settings.c, 0., 1.);
+
+	ImGui::Text("%zu nodes", settings.getNodeCount());
+
+	bool valid = settings.isValid();
+	if (!valid)
+		ImGui::TextUnformatted("a + b + c must not exceed 1");
+
+	ImGui::BeginDisabled(!valid);
+	bool generate = ImGui::Button("Generate");
+	ImGui::EndDisabled();
+
+	return generate;
+}
+
+void Main::generateRandomModelGraph()
+{
+	auto edges = GenerateRandomGraph(m_random_graph_settings);
+	auto nodes = m_object_manager.addGraph(m_random_graph_settings.getNodeCount(), edges);
+
+	// Scatter the nodes over an area that gives every node about the same room
+	// as the layouts do, the layouts can then untangle them
+	auto center = m_render_window.mapPixelToCoords(m_rmb_menu_pos);
+	float half_side = .5f * config::layout_edge_length * std::sqrt(static_cast<float>(nodes.size()));
+
+	std::mt19937 gen(static_cast<uint32_t>(m_random_graph_settings.seed));
+	std::uniform_real_distribution<float> offset(-half_side, half_side);
+
+	for (auto* node: nodes)
+		node->setPosition(center + sf::Vector2f(offset(gen), offset(gen)));
 }
 
 //========================================
 
-int main()
+int main(int argc, char** argv)
 {
+	for (int i = 1; i < argc; i++)
+		if (std::string_view(argv[i]) == "--headless")
+			return RunHeadless(argc, argv);
+
 	Main instance;
 	instance.run();
 
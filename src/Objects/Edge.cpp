@@ -1,5 +1,7 @@
+#include <cassert>
 #include <cmath>
 #include <numbers>
+#include <utility>
 #include <format>
 
 #include <Graph/Objects/Edge.hpp>
@@ -16,21 +18,22 @@ Edge::Edge():
 	Object()
 {
 	m_rectangle.setFillColor(config::edge_default_color);
+
+	m_arrow.setPointCount(3);
+	m_arrow.setPoint(0, sf::Vector2f(0, 0));
+	m_arrow.setPoint(1, sf::Vector2f(-config::edge_arrow_size, -.5f * config::edge_arrow_size));
+	m_arrow.setPoint(2, sf::Vector2f(-config::edge_arrow_size,  .5f * config::edge_arrow_size));
+
 	m_text.setCharacterSize(config::font_size);
 
 	setWeight(m_weight);
 }
-						
-void Edge::onAdded(ObjectManager* manager)
-{
-	Object::onAdded(manager);
-	m_text.setFont(*manager->getFont());
-}
 
 //========================================
 
 void Edge::setThickness(float thickness)
 {
+	invalidateGeometry();
 	m_thickness = thickness;
 }
 
@@ -41,6 +44,7 @@ float Edge::getThickness() const
 
 void Edge::setColor(sf::Color color)
 {
+	invalidateAppearance();
 	m_color = color;
 }
 
@@ -53,6 +57,8 @@ sf::Color Edge::getColor() const
 
 void Edge::setNodeA(Node* node)
 {
+	invalidateGeometry();
+
 	if (m_node_a)
 		m_node_a->onEdgeDisconnected(this);
 
@@ -66,6 +72,7 @@ void Edge::setNodeA(Node* node)
 		);
 
 	node->onEdgeConnected(this);
+	m_object_manager->onGraphChanged(GraphChange::Edges);
 }
 
 Node* Edge::getNodeA() const
@@ -75,6 +82,8 @@ Node* Edge::getNodeA() const
 
 void Edge::setNodeB(Node* node)
 {
+	invalidateGeometry();
+
 	if (m_node_b)
 		m_node_b->onEdgeDisconnected(this);
 
@@ -82,6 +91,7 @@ void Edge::setNodeB(Node* node)
 	m_connecting = false;
 
 	node->onEdgeConnected(this);
+	m_object_manager->onGraphChanged(GraphChange::Edges);
 }
 
 Node* Edge::getNodeB() const
@@ -89,9 +99,27 @@ Node* Edge::getNodeB() const
 	return m_node_b;
 }
 
+void Edge::attach(Node* a, Node* b)
+{
+	assert(!m_node_a && !m_node_b);
+
+	invalidateGeometry();
+
+	m_node_a = a;
+	m_node_b = b;
+	m_connecting = false;
+}
+
 void Edge::setWeight(int weight)
 {
+	invalidateGeometry();
+
+	m_weight = weight;
 	m_text.setString(std::to_string(m_weight));
+
+	// Called from the constructor before the edge is added
+	if (m_object_manager)
+		m_object_manager->onGraphChanged(GraphChange::Weights);
 }
 
 int Edge::getWeight() const
@@ -99,6 +127,36 @@ int Edge::getWeight() const
 	return m_weight;
 }
 
+void Edge::setDirected(bool directed)
+{
+	invalidateGeometry();
+	m_directed = directed;
+
+	// Called by bulk insertion before the edge is added
+	if (m_object_manager)
+		m_object_manager->onGraphChanged(GraphChange::Edges);
+}
+
+bool Edge::isDirected() const
+{
+	return m_directed;
+}
+
+void Edge::reverse()
+{
+	invalidateGeometry();
+	std::swap(m_node_a, m_node_b);
+
+	m_object_manager->onGraphChanged(GraphChange::Edges);
+}
+
+bool Edge::leadsFrom(Node* node) const
+{
+	assert(node && (node == m_node_a || node == m_node_b));
+
+	return !m_directed || node == m_node_a;
+}
+
 Node* Edge::opposite(Node* node) const
 {
 	assert(node && (node == m_node_a || node == m_node_b));
@@ -125,6 +183,7 @@ bool Edge::onEvent(const sf::Event& event)
 		case sf::Event::MouseMoved:
 			if (m_connecting)
 			{
+				invalidateGeometry();
 				m_connecting_end = sf::Vector2f(
 					m_object_manager->getWindow()->mapPixelToCoords(
 						sf::Vector2i(
@@ -153,24 +212,88 @@ bool Edge::onEvent(const sf::Event& event)
 
 //========================================
 
-void Edge::draw()
+void Edge::draw(sf::RenderTarget& target)
 {
+	if (m_geometry_dirty)
+		updateGeometry();
+
+	if (m_appearance_dirty)
+		updateAppearance();
+
+	target.draw(m_rectangle);
+
+	if (m_directed && m_length > 0)
+		target.draw(m_arrow);
+
+	target.draw(m_text);
+}
+
+sf::FloatRect Edge::getBounds()
+{
+	// Edges are added before their ends are set
+	if (!m_node_a || (!m_node_b && !m_connecting))
+		return {};
+
+	if (m_geometry_dirty)
+		updateGeometry();
+
+	return m_bounds;
+}
+
+void Edge::updateGeometry()
+{
+	// Bound on first use, so that bulk insertion has no per edge setup
+	if (!m_text.getFont())
+		m_text.setFont(*m_object_manager->getFont());
+
 	auto a = getAPosition();
 	auto b = getBPosition();
 
 	auto direction = b - a;	
-	float length = sqrt(direction.x*direction.x + direction.y*direction.y);
+	m_length = sqrt(direction.x*direction.x + direction.y*direction.y);
 	auto angle = atan2(direction.y, direction.x);
 	auto center = a + .5f * direction;
 
 	m_rectangle.setPosition(center);
 	m_rectangle.setRotation((180.0 / std::numbers::pi) * angle);
-	m_rectangle.setSize(sf::Vector2f(length, m_thickness));
+	m_rectangle.setSize(sf::Vector2f(m_length, m_thickness));
 	m_rectangle.setOrigin(m_rectangle.getSize() * .5f);
 
+	m_geometry_dirty = false;
+
+	if (m_length == 0)
+	{
+		m_bounds = Union(m_rectangle.getGlobalBounds(), m_text.getGlobalBounds());
+		return;
+	}
+
+	// The arrowhead touches the circle of node B
+	if (m_directed)
+	{
+		float offset = m_connecting
+			? 0
+			: m_node_b->getRadius();
+
+		m_arrow.setPosition(b - offset * direction / m_length);
+		m_arrow.setRotation((180.0 / std::numbers::pi) * angle);
+	}
+
+	m_text.setPosition(center + 20.f * sf::Vector2f(-direction.y, direction.x) / m_length);
+
+	m_bounds = Union(m_rectangle.getGlobalBounds(), m_text.getGlobalBounds());
+	if (m_directed)
+		m_bounds = Union(m_bounds, m_arrow.getGlobalBounds());
+}
+
+void Edge::updateAppearance()
+{
 	auto color = m_path_indication
 		? config::edge_path_color
-		: m_color;
+		: m_cut_indication
+			? config::edge_cut_color
+			: m_highlight
+				? config::edge_highlight_color
+				: m_color;
 
 	m_rectangle.setFillColor(
 		m_hovered
@@ -178,12 +301,15 @@ void Edge::draw()
 			: color
 	);
 
-	m_object_manager->getWindow()->draw(m_rectangle);
-
+	m_arrow.setFillColor(m_rectangle.getFillColor());
 	m_text.setFillColor(color);
-	m_text.setPosition(center + 20.f * sf::Vector2f(-direction.y, direction.x) / length);
 
-	m_object_manager->getWindow()->draw(m_text);
+	m_appearance_dirty = false;
+}
+
+void Edge::onHoverChanged()
+{
+	invalidateAppearance();
 }
 
 bool Edge::intersect(const sf::Vector2f& point)	const
@@ -237,8 +363,8 @@ bool Edge::intersect(const sf::Vector2f& point)	const
 		-e1.y * (point.x - a.x) + e1.x * (point.y - a.y)
 	);
 
-	auto size = m_rectangle.getSize();
-	return 0 <= e_point.x && e_point.x < size.x && abs(e_point.y) <= .5f * size.y;
+	// The rectangle may be out of date while the edge is not drawn
+	return 0 <= e_point.x && e_point.x < length && abs(e_point.y) <= .5f * m_thickness;
 }
 
 //========================================
@@ -250,12 +376,25 @@ const char* Edge::getName() const
 
 void Edge::onPropertiesShow()
 {
-	ImGui::SliderFloat("Thickness", &m_thickness, 1.f, 20.f);
-	ImGui::ColorEdit3("Color", &m_color);
+	if (ImGui::SliderFloat("Thickness", &m_thickness, 1.f, 20.f))
+		setThickness(m_thickness);
+
+	if (ImGui::ColorEdit3("Color", &m_color))
+		setColor(m_color);
 
 	if (ImGui::SliderInt("Weight", &m_weight, 1, 100))
 		setWeight(m_weight);
 
+	if (ImGui::Checkbox("Directed", &m_directed))
+		setDirected(m_directed);
+
+	if (m_directed)
+	{
+		ImGui::SameLine();
+		if (ImGui::Button("Reverse"))
+			reverse();
+	}
+
 	ImGui::Text("Connected nodes:");
 	if (ImGui::BeginTable("table_connected_nodes", 2, ImGuiTableFlags_Borders))
 	{
@@ -308,7 +447,37 @@ void Edge::onDelete()
 
 void Edge::setPathIndication(bool enable)
 {
+	invalidateAppearance();
 	m_path_indication = enable;
 }
 
+void Edge::setCutIndication(bool enable)
+{
+	invalidateAppearance();
+	m_cut_indication = enable;
+}
+
+void Edge::invalidateGeometry()
+{
+	requestRedraw();
+	m_geometry_dirty = true;
+}
+
+void Edge::invalidateAppearance()
+{
+	requestRedraw();
+	m_appearance_dirty = true;
+}
+
+void Edge::setHighlight(bool enable)
+{
+	invalidateAppearance();
+	m_highlight = enable;
+}
+
+bool Edge::isHighlighted() const
+{
+	return m_highlight;
+}
+
 //========================================
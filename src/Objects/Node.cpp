@@ -37,6 +37,7 @@ Node::Node():
 
 void Node::setPosition(const sf::Vector2f& position)
 {
+	invalidateGeometry();
 	m_circle.setPosition(position);
 }
 
@@ -47,6 +48,7 @@ const sf::Vector2f& Node::getPosition() const
 
 void Node::setRadius(float radius)
 {
+	invalidateGeometry();
 	m_radius = radius;
 }
 
@@ -57,6 +59,7 @@ float Node::getRadius() const
 
 void Node::setColor(sf::Color color)
 {
+	invalidateAppearance();
 	m_color = color;
 }
 
@@ -67,6 +70,10 @@ sf::Color Node::getColor() const
 
 void Node::setLabel(std::string_view label)
 {
+	// Only the label moves, the edges stay where they are
+	requestRedraw();
+	m_geometry_dirty = true;
+
 	m_label = label;
 	m_text.setString(std::string(label));
 }
@@ -109,31 +116,75 @@ Edge* Node::isAdjacent(Node* node) const
 
 //========================================
 
-void Node::draw()
+void Node::draw(sf::RenderTarget& target)
+{
+	if (m_geometry_dirty)
+		updateGeometry();
+
+	if (m_appearance_dirty)
+		updateAppearance();
+
+	target.draw(m_circle);
+	target.draw(m_text);
+}
+
+sf::FloatRect Node::getBounds()
 {
+	if (m_geometry_dirty)
+		updateGeometry();
+
+	return m_bounds;
+}
+
+void Node::invalidateGeometry()
+{
+	requestRedraw();
+	m_geometry_dirty = true;
+
+	// Only the edges touching the node follow it
+	for (auto* edge: m_connected_edges)
+		edge->invalidateGeometry();
+}
+
+void Node::invalidateAppearance()
+{
+	requestRedraw();
+	m_appearance_dirty = true;
+}
+
+void Node::updateGeometry()
+{
+	// Bound on first use, so that bulk insertion has no per node setup
+	if (!m_text.getFont())
+		m_text.setFont(*m_object_manager->getFont());
+
 	m_circle.setRadius(m_radius);
 	m_circle.setOrigin(m_radius, m_radius);
+
+	auto bounds = m_text.getLocalBounds();
+	m_text.setOrigin(bounds.width / 2, 0);
+	m_text.setPosition(m_circle.getPosition() + sf::Vector2f(0, m_circle.getRadius() + 10));
+
+	m_bounds = Union(m_circle.getGlobalBounds(), m_text.getGlobalBounds());
+	m_geometry_dirty = false;
+}
+
+void Node::updateAppearance()
+{
 	m_circle.setFillColor(
 		m_hovered
 			? Interpolate(m_color, sf::Color::White, .5f)
 			: m_color
 	);
 
-	m_object_manager->getWindow()->draw(m_circle);
-
-	m_text.setString(m_label);
-
-	auto bounds = m_text.getGlobalBounds();
-	m_text.setOrigin(bounds.width / 2, 0);
-	m_text.setPosition(m_circle.getPosition() + sf::Vector2f(0, m_circle.getRadius() + 10));
-
-	m_object_manager->getWindow()->draw(m_text);
+	m_appearance_dirty = false;
 }
 
+// The shapes may be out of date while the node is not drawn
 bool Node::intersect(const sf::Vector2f& point) const
 {				
 	auto distance = point - m_circle.getPosition();
-	return distance.x*distance.x + distance.y*distance.y < pow(m_circle.getRadius(), 2);
+	return distance.x*distance.x + distance.y*distance.y < m_radius * m_radius;
 }
 
 //========================================
@@ -211,9 +262,14 @@ bool Node::onEvent(const sf::Event& event)
 
 void Node::onPropertiesShow()
 {
-	ImGui::SliderFloat("Radius", &m_radius, 5, 100);
-	ImGui::ColorEdit3("Color", &m_color);
-	ImGui::InputText("Label", &m_label);
+	if (ImGui::SliderFloat("Radius", &m_radius, 5, 100))
+		setRadius(m_radius);
+
+	if (ImGui::ColorEdit3("Color", &m_color))
+		setColor(m_color);
+
+	if (ImGui::InputText("Label", &m_label))
+		setLabel(std::string(m_label));
 
 	if (!m_connected_edges.empty())
 	{
@@ -252,6 +308,12 @@ bool Node::onRMBMenuShow()
 			m_object_manager->pathSearchDst(this);
 			return true;
 		}
+
+		if (ImGui::Selectable("Max flow"))
+		{
+			m_object_manager->maxFlowDst(this);
+			return true;
+		}
 	}
 
 	else if (ImGui::Selectable("Start path"))
@@ -266,12 +328,6 @@ bool Node::onRMBMenuShow()
 
 //========================================
 
-void Node::onAdded(ObjectManager* manager)
-{
-	Object::onAdded(manager);
-	m_text.setFont(*manager->getFont());
-}
-
 void Node::onDelete()
 {
 	auto copy = m_connected_edges;
@@ -281,6 +337,12 @@ void Node::onDelete()
 	m_object_manager->onNodeDeleted(this);
 }
 
+void Node::onHoverChanged()
+{
+	invalidateAppearance();
+	m_object_manager->onNodeHovered(this, m_hovered);
+}
+
 void Node::onEdgeConnected(Edge* edge)
 {
 	if (
@@ -305,6 +367,11 @@ void Node::onEdgeDisconnected(Edge* edge)
 		m_connected_edges.erase(iter);
 }
 
+void Node::onEdgesConnected(std::span<Edge* const> edges)
+{
+	m_connected_edges.insert(m_connected_edges.end(), edges.begin(), edges.end());
+}
+
 const std::vector<Edge*>& Node::getConnectedEdges() const
 {
 	return m_connected_edges;
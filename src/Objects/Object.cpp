@@ -114,6 +114,13 @@ void Object::onHoverChanged()
 {
 }
 
+void Object::requestRedraw()
+{
+	// Objects not added yet have never been drawn
+	if (m_object_manager)
+		m_object_manager->onObjectChanging(this);
+}
+
 int Object::getPriority() const
 {
 	return 0;
@@ -0,0 +1,126 @@
+#include <cassert>
+
+#include <Graph/Objects/ObjectGraph.hpp>
+#include <Graph/Objects/ObjectManager.hpp>
+
+//========================================
+
+ObjectGraph::ObjectGraph():
+	m_nodes(std::make_shared<const NodeTable>()),
+	m_edge_objects(std::make_shared<const std::vector<Edge*>>())
+{}
+
+ObjectGraph::ObjectGraph(CompactGraph graph):
+	CompactGraph(std::move(graph))
+{}
+
+ObjectGraph ObjectGraph::Build(ObjectManager& manager)
+{
+	auto nodes = std::make_shared<NodeTable>();
+	nodes->objects = manager.findAll<Node>();
+	nodes->indices.reserve(nodes->objects.size());
+
+	for (index_t i = 0; i < nodes->objects.size(); i++)
+		nodes->indices.emplace(nodes->objects[i], i);
+
+	return Connect(manager, std::move(nodes));
+}
+
+ObjectGraph ObjectGraph::Rebuild(ObjectManager& manager, const ObjectGraph& previous)
+{
+	return Connect(manager, previous.m_nodes);
+}
+
+ObjectGraph ObjectGraph::Reweight(const ObjectGraph& previous)
+{
+	std::vector<int> weights;
+	weights.reserve(previous.m_edge_objects->size());
+
+	for (auto* edge: *previous.m_edge_objects)
+		weights.push_back(edge->getWeight());
+
+	ObjectGraph graph(previous.reweighted(weights));
+	graph.m_nodes = previous.m_nodes;
+	graph.m_edge_objects = previous.m_edge_objects;
+
+	return graph;
+}
+
+ObjectGraph ObjectGraph::Connect(ObjectManager& manager, std::shared_ptr<const NodeTable> nodes)
+{
+	auto edges = manager.findAll<Edge>();
+
+	std::vector<EdgeRecord> records;
+	auto edge_objects = std::make_shared<std::vector<Edge*>>();
+
+	records.reserve(edges.size());
+	edge_objects->reserve(edges.size());
+
+	for (auto* edge: edges)
+	{
+		// Skip the edge that is being connected right now
+		if (!edge->getNodeA() || !edge->getNodeB())
+			continue;
+
+		records.push_back({
+			nodes->indices.at(edge->getNodeA()),
+			nodes->indices.at(edge->getNodeB()),
+			edge->getWeight(),
+			edge->isDirected()
+		});
+
+		edge_objects->push_back(edge);
+	}
+
+	ObjectGraph graph(CompactGraph(nodes->objects.size(), records));
+	graph.m_nodes = std::move(nodes);
+	graph.m_edge_objects = std::move(edge_objects);
+
+	return graph;
+}
+
+//========================================
+
+Node* ObjectGraph::getNodeObject(index_t node) const
+{
+	return m_nodes->objects[node];
+}
+
+Edge* ObjectGraph::getEdgeObject(index_t edge) const
+{
+	return (*m_edge_objects)[edge];
+}
+
+const std::vector<Node*>& ObjectGraph::getNodeObjects() const
+{
+	return m_nodes->objects;
+}
+
+const std::vector<Edge*>& ObjectGraph::getEdgeObjects() const
+{
+	return *m_edge_objects;
+}
+
+bool ObjectGraph::contains(Node* node) const
+{
+	return m_nodes->indices.contains(node);
+}
+
+ObjectGraph::index_t ObjectGraph::indexOf(Node* node) const
+{
+	assert(contains(node));
+	return m_nodes->indices.at(node);
+}
+
+std::vector<sf::Vector2f> ObjectGraph::getPositions() const
+{
+	std::vector<sf::Vector2f> positions;
+	positions.reserve(m_nodes->objects.size());
+
+	for (auto* node: m_nodes->objects)
+		positions.push_back(node->getPosition());
+
+	return positions;
+}
+
+//========================================
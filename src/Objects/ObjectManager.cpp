@@ -1,19 +1,42 @@
 #include <cassert>
 #include <algorithm>
+#include <cmath>
 #include <format>
+#include <numeric>
+#include <random>
 
 #include <Graph/Objects/ObjectManager.hpp>
+#include <Graph/Objects/ObjectGraph.hpp>
 #include <Graph/Objects/Object.hpp>
 
 #include <Graph/Path.hpp>
 #include <Graph/ImGuiExtra.hpp>
+#include <Graph/Algorithms/Layout.hpp>
+
+//========================================
+
+namespace
+{
+
+const char* path_strategy_names[] = {
+	"Breadth-first",
+	"Dijkstra",
+	"Bidirectional Dijkstra"
+};
+
+} // namespace
 
 //========================================
 
 ObjectManager::~ObjectManager()
 {
+	m_tasks.cancelAll();
+
 	for (auto* object: m_objects)
 		delete object;
+
+	for (auto [object, epoch]: m_retired)
+		delete object;
 }
 
 //========================================
@@ -38,6 +61,21 @@ sf::Font* ObjectManager::getFont() const
 	return m_font;
 }
 
+void ObjectManager::setProfiler(Profiler* profiler)
+{
+	m_profiler = profiler;
+}
+
+void ObjectManager::setTiledRendering(bool enable)
+{
+	m_tiled_rendering = enable;
+}
+
+bool ObjectManager::isTiledRendering() const
+{
+	return m_tiled_rendering;
+}
+
 //========================================
 
 void ObjectManager::edgeConnectionStart(Node* node)
@@ -71,10 +109,18 @@ bool ObjectManager::edgeConnectionComplete(Node* node /*= nullptr*/)
 void ObjectManager::pathSearchSrc(Node* node)
 {
 	m_path_src = node;
+
+	// The result of the previous query is not about the new source
+	m_tasks.cancel("Maximum flow");
+	resetMaxFlow();
+
+	resetPathPreview();
+	findPathTree();
 }
 
 void ObjectManager::pathSearchDst(Node* node)
 {
+	resetPathPreview();
 	m_path = Path::Empty();
 
 	assert(m_path_src);
@@ -87,7 +133,157 @@ void ObjectManager::pathSearchDst(Node* node)
 	}
 
 	m_pathfind_overlay_show = true;
-	m_path = Path::Shortest(m_path_src, m_path_dst);
+	findPath();
+}
+
+void ObjectManager::findPath()
+{
+	m_path = Path::Empty();
+
+	const auto& graph = getGraph();
+	auto src = graph.indexOf(m_path_src);
+	auto dst = graph.indexOf(m_path_dst);
+
+	// Nodes in different components are answered without a search
+	if (!getComponents().connected(src, dst))
+	{
+		m_path = Path::Unreachable();
+		recordPath();
+		return;
+	}
+
+	runGraphTask(
+		"Path search",
+		[src, dst, strategy = m_path_strategy](const ObjectGraph& graph, TaskContext&)
+		{
+			return ShortestPath(graph, src, dst, strategy);
+		},
+		[this](const ObjectGraph& graph, CompactPath& path, float)
+		{
+			// The path must not go through objects deleted in the meantime
+			if (!isCurrent(graph))
+				return;
+
+			m_path = Path::FromCompact(graph, path);
+			recordPath();
+		}
+	);
+}
+
+void ObjectManager::recordPath()
+{
+	m_path_history.push_front({
+		std::string(m_path_src->getLabel()),
+		std::string(m_path_dst->getLabel()),
+		m_path_strategy,
+		static_cast<bool>(m_path),
+		m_path.getLength(),
+		m_path.getWeight(),
+		m_path.getStats()
+	});
+
+	if (m_path_history.size() > config::path_history_size)
+		m_path_history.pop_back();
+}
+
+void ObjectManager::findPathTree()
+{
+	m_path_tree.reset();
+	m_path_tree_graph.reset();
+	m_path_tree_strategy = m_path_strategy;
+
+	const auto& graph = getGraph();
+	runGraphTask(
+		"Path tree",
+		[src = graph.indexOf(m_path_src), strategy = m_path_strategy](const ObjectGraph& graph, TaskContext&)
+		{
+			return ShortestPaths(graph, src, strategy);
+		},
+		[this, snapshot = getGraphSnapshot()](const ObjectGraph&, ShortestPathTree& tree, float)
+		{
+			m_path_tree = std::move(tree);
+			m_path_tree_graph = snapshot;
+			m_preview_node = nullptr;
+		}
+	);
+}
+
+void ObjectManager::updatePathPreview()
+{
+	// Only while the destination is being chosen
+	if (!m_path_src || m_path_dst || !m_hovered_node || m_hovered_node == m_path_src)
+	{
+		resetPathPreview();
+		return;
+	}
+
+	bool stale = !m_path_tree_graph || !isCurrent(*m_path_tree_graph) || m_path_tree_strategy != m_path_strategy;
+	if (stale)
+	{
+		resetPathPreview();
+		if (!m_tasks.isRunning("Path tree"))
+			findPathTree();
+
+		return;
+	}
+
+	if (m_hovered_node == m_preview_node)
+		return;
+
+	m_preview_node = m_hovered_node;
+	m_path_preview.clear(m_path);
+	m_path_preview = Path::FromCompact(*m_path_tree_graph, m_path_tree->getPath(m_path_tree_graph->indexOf(m_hovered_node)));
+}
+
+void ObjectManager::resetPathPreview()
+{
+	// Edges shared with the path found keep its highlight
+	m_path_preview.clear(m_path);
+	m_preview_node = nullptr;
+}
+
+void ObjectManager::resetMaxFlow()
+{
+	for (auto* edge: m_cut_edges)
+		edge->setCutIndication(false);
+
+	m_cut_edges.clear();
+	m_flow.reset();
+}
+
+void ObjectManager::maxFlowDst(Node* node)
+{
+	assert(m_path_src && node);
+
+	resetPathPreview();
+	m_path = Path::Empty();
+	m_path_dst = node;
+
+	const auto& graph = getGraph();
+	runGraphTask(
+		"Maximum flow",
+		[src = graph.indexOf(m_path_src), dst = graph.indexOf(m_path_dst)](const ObjectGraph& graph, TaskContext&)
+		{
+			return MaximumFlow(graph, src, dst);
+		},
+		[this](const ObjectGraph& graph, MaxFlowResult& flow, float)
+		{
+			if (!isCurrent(graph))
+				return;
+
+			resetMaxFlow();
+			for (auto edge: flow.cut_edges)
+			{
+				Edge* object = graph.getEdgeObject(edge);
+				object->setCutIndication(true);
+				m_cut_edges.push_back(object);
+			}
+
+			m_flow = std::move(flow);
+		}
+	);
+
+	m_pathfind_overlay_show = true;
 }
 
 Node* ObjectManager::getPathSrc()
@@ -102,6 +298,15 @@ Node* ObjectManager::getPathDst()
 
 void ObjectManager::cancelPathSearch()
 {
+	m_tasks.cancel("Path search");
+	m_tasks.cancel("Path tree");
+	m_tasks.cancel("Maximum flow");
+
+	resetPathPreview();
+	m_path_tree.reset();
+	m_path_tree_graph.reset();
+	resetMaxFlow();
+
 	m_path = Path::Empty();
 	m_pathfind_overlay_show = false;
 	m_path_src = nullptr;
@@ -125,6 +330,7 @@ void ObjectManager::deleteObject(Object* object)
 	{
 		m_deleted_objects.push_back(iter);
 		object->onDelete();
+		onGraphChanged(dynamic_cast<Edge*>(object) ? GraphChange::Edges : GraphChange::Nodes);
 	}
 }
 
@@ -138,10 +344,337 @@ void ObjectManager::clear()
 	m_clear = true;
 }
 
+bool ObjectManager::saveToFile(const std::filesystem::path& path)
+{
+	auto graph = ObjectGraph::Build(*this);
+
+	GraphData data;
+	for (auto* node: graph.getNodeObjects())
+	{
+		data.labels.emplace_back(node->getLabel());
+		data.positions.push_back(node->getPosition());
+	}
+
+	for (size_t i = 0; i < graph.getEdgeCount(); i++)
+		data.edges.push_back(graph.getEdge(static_cast<CompactGraph::index_t>(i)));
+
+	return data.saveToFile(path);
+}
+
+bool ObjectManager::loadFromFile(const std::filesystem::path& path)
+{
+	GraphData data;
+	if (!data.loadFromFile(path))
+		return false;
+
+	clear();
+	m_pending_import = std::move(data);
+
+	return true;
+}
+
+std::vector<Node*> ObjectManager::addNodes(size_t count)
+{
+	std::vector<Node*> nodes(count);
+	for (auto& node: nodes)
+		node = new Node;
+
+	insertBatch(nodes);
+	return nodes;
+}
+
+std::vector<Edge*> ObjectManager::addEdges(std::span<Node* const> nodes, std::span<const CompactGraph::EdgeRecord> edges)
+{
+	std::vector<Edge*> objects(edges.size());
+	for (size_t i = 0; i < edges.size(); i++)
+	{
+		const auto& record = edges[i];
+		assert(record.a < nodes.size() && record.b < nodes.size());
+
+		objects[i] = new Edge;
+		objects[i]->attach(nodes[record.a], nodes[record.b]);
+
+		if (record.weight != config::edge_default_weight)
+			objects[i]->setWeight(record.weight);
+
+		if (record.directed)
+			objects[i]->setDirected(true);
+	}
+
+	insertBatch(objects);
+
+	// Group the new edges by node, so that every adjacency list grows once
+	std::vector<size_t> offsets(nodes.size() + 1, 0);
+	for (const auto& record: edges)
+	{
+		offsets[record.a + 1]++;
+		if (record.a != record.b)
+			offsets[record.b + 1]++;
+	}
+
+	std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+	std::vector<Edge*> incident(offsets.back());
+	std::vector<size_t> heads(offsets.begin(), offsets.end() - 1);
+
+	for (size_t i = 0; i < edges.size(); i++)
+	{
+		incident[heads[edges[i].a]++] = objects[i];
+		if (edges[i].a != edges[i].b)
+			incident[heads[edges[i].b]++] = objects[i];
+	}
+
+	for (size_t i = 0; i < nodes.size(); i++)
+		nodes[i]->onEdgesConnected(std::span(incident).subspan(offsets[i], offsets[i + 1] - offsets[i]));
+
+	return objects;
+}
+
+std::vector<Node*> ObjectManager::addGraph(size_t node_count, std::span<const CompactGraph::EdgeRecord> edges)
+{
+	auto nodes = addNodes(node_count);
+	addEdges(nodes, edges);
+
+	return nodes;
+}
+
+void ObjectManager::import(const GraphData& data)
+{
+	auto nodes = addGraph(data.labels.size(), data.edges);
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		nodes[i]->setLabel(data.labels[i]);
+
+		if (data.hasPositions())
+			nodes[i]->setPosition(data.positions[i]);
+	}
+
+	if (data.hasPositions())
+		return;
+
+	// Text edge lists have no positions. The nodes are scattered over an area
+	// that gives every node about the same room as the layout does, until
+	// the layout computed in the background replaces them
+	float half_side = .5f * config::layout_edge_length * std::sqrt(static_cast<float>(nodes.size()));
+
+	std::mt19937 gen;
+	std::uniform_real_distribution<float> offset(-half_side, half_side);
+
+	for (auto* node: nodes)
+		node->setPosition(sf::Vector2f(offset(gen), offset(gen)));
+
+	runGraphTask(
+		"Layout",
+		[](const ObjectGraph& graph, TaskContext&)
+		{
+			MultilevelLayoutSettings settings;
+			settings.edge_length = config::layout_edge_length;
+
+			return MultilevelLayout(graph, settings);
+		},
+		[this](const ObjectGraph& graph, std::vector<sf::Vector2f>& positions, float)
+		{
+			if (isCurrent(graph))
+				applyLayout(graph, positions, false);
+		}
+	);
+}
+
+const ObjectGraph& ObjectManager::getGraph()
+{
+	return *getGraphSnapshot();
+}
+
+std::shared_ptr<const ObjectGraph> ObjectManager::getGraphSnapshot()
+{
+	if (m_graph_built_version == m_graph_version)
+		return m_graph;
+
+	// Whatever has not changed is shared with the previous snapshot, which
+	// the tasks still reading it keep alive
+	switch (m_graph_change)
+	{
+		case GraphChange::Weights:
+			m_graph = std::make_shared<const ObjectGraph>(ObjectGraph::Reweight(*m_graph));
+			break;
+
+		case GraphChange::Edges:
+			m_graph = std::make_shared<const ObjectGraph>(ObjectGraph::Rebuild(*this, *m_graph));
+			break;
+
+		case GraphChange::Nodes:
+			m_graph = std::make_shared<const ObjectGraph>(ObjectGraph::Build(*this));
+			break;
+	}
+
+	m_graph_built_version = m_graph_version;
+	m_graph_change = GraphChange::Weights;
+	m_snapshots.emplace_back(m_graph_version, m_graph);
+
+	return m_graph;
+}
+
+bool ObjectManager::isCurrent(const ObjectGraph& graph) const
+{
+	return m_graph.get() == &graph && m_graph_built_version == m_graph_version;
+}
+
+const Components& ObjectManager::getComponents()
+{
+	if (m_components_version != m_topology_version)
+	{
+		m_components = ConnectedComponents(getGraph());
+		m_components_version = m_topology_version;
+	}
+
+	return m_components;
+}
+
+void ObjectManager::onGraphChanged(GraphChange change /*= GraphChange::Nodes*/)
+{
+	m_graph_version++;
+	m_graph_change = std::max(m_graph_change, change);
+
+	if (change != GraphChange::Weights)
+		m_topology_version++;
+}
+
+size_t ObjectManager::getGraphVersion() const
+{
+	return m_graph_version;
+}
+
+size_t ObjectManager::getTopologyVersion() const
+{
+	return m_topology_version;
+}
+
+BackgroundTasks& ObjectManager::getTasks()
+{
+	return m_tasks;
+}
+
+void ObjectManager::applyLayout(const ObjectGraph& graph, const std::vector<sf::Vector2f>& positions, bool animate /*= true*/)
+{
+	assert(positions.size() == graph.getNodeCount());
+	if (positions.empty())
+		return;
+
+	sf::Vector2f min = positions.front(), max = positions.front();
+	for (const auto& position: positions)
+	{
+		min.x = std::min(min.x, position.x);
+		min.y = std::min(min.y, position.y);
+		max.x = std::max(max.x, position.x);
+		max.y = std::max(max.y, position.y);
+	}
+
+	// Shrink the layout to fit the view if it is too large, keep it as is otherwise
+	const auto& view = m_window->getView();
+	auto size = max - min;
+
+	float scale = std::min({
+		1.f,
+		.9f * view.getSize().x / std::max(size.x, 1.f),
+		.9f * view.getSize().y / std::max(size.y, 1.f)
+	});
+
+	auto center = .5f * (min + max);
+
+	m_animations.clear();
+	if (animate)
+		m_animations.reserve(positions.size());
+
+	for (CompactGraph::index_t i = 0; i < positions.size(); i++)
+	{
+		Node* node = graph.getNodeObject(i);
+		auto target = view.getCenter() + scale * (positions[i] - center);
+
+		if (animate)
+			m_animations.push_back({ node, node->getPosition(), target });
+
+		else
+			node->setPosition(target);
+	}
+
+	m_animation_clock.restart();
+}
+
+bool ObjectManager::isAnimating() const
+{
+	return !m_animations.empty();
+}
+
+void ObjectManager::update()
+{
+	updatePathPreview();
+
+	if (m_animations.empty())
+		return;
+
+	float t = std::min(1.f, m_animation_clock.getElapsedTime().asSeconds() / config::layout_animation_duration);
+	float ease = t * t * (3 - 2 * t);
+
+	for (const auto& [node, from, to]: m_animations)
+		node->setPosition(from + ease * (to - from));
+
+	if (t >= 1)
+		m_animations.clear();
+}
+
 void ObjectManager::drawObjects()
 {
+	// Small graphs are drawn faster than their tiles would be
+	bool tiled = m_tiled_rendering && m_objects.size() >= config::tile_cache_min_objects;
+	if (tiled != m_tiles_active)
+	{
+		m_tiles_active = tiled;
+		m_tiles_stale = true;
+	}
+
+	// After a bulk change the objects are drawn directly for a frame, in case
+	// they keep changing, and the tiles start over afterwards
+	if (m_tiles_stale)
+	{
+		m_tile_cache.clear();
+		m_changed_objects.clear();
+		m_tiles_stale = false;
+	}
+
+	else if (m_tiles_active)
+	{
+		ProfileScope scope(m_profiler, "Tiles");
+
+		for (auto* object: m_changed_objects)
+			m_tile_cache.update(object);
+
+		m_changed_objects.clear();
+
+		if (m_tile_cache.draw(*m_window, m_objects))
+			return;
+
+		// Out of texture memory, drawn directly from now on
+		m_tiled_rendering = false;
+	}
+
+	// Objects are ordered by priority, so every type is drawn in one run
+	const char* type = nullptr;
 	for (auto* object: m_objects)
-		object->draw();
+	{
+		if (m_profiler && object->getName() != type)
+		{
+			if (type)
+				m_profiler->end();
+
+			type = object->getName();
+			m_profiler->begin(type);
+		}
+
+		object->draw(*m_window);
+	}
+
+	if (type)
+		m_profiler->end();
 }
 
 bool ObjectManager::onEvent(const sf::Event& event)
@@ -175,6 +708,18 @@ void ObjectManager::processInterface()
 	for (auto* object: m_objects)
 		object->processInterface();
 
+	m_tasks.processInterface();
+
+	if (m_preview_node && !ImGui::GetIO().WantCaptureMouse)
+	{
+		auto text = m_path_preview.getString();
+		if (m_path_preview)
+			ImGui::SetTooltip("%.*s\nLength: %zu, weight: %d", static_cast<int>(text.length()), text.data(), m_path_preview.getLength(), m_path_preview.getWeight());
+
+		else
+			ImGui::SetTooltip("%.*s", static_cast<int>(text.length()), text.data());
+	}
+
 	if (m_pathfind_overlay_show)
 	{
 		constexpr auto padding = 10.f;
@@ -195,15 +740,136 @@ void ObjectManager::processInterface()
 			)
 		)
 		{							
-			ImGui::Text("Path");
-			ImGui::Separator();
+			if (m_flow)
+			{
+				auto src = m_path_src->getLabel();
+				auto dst = m_path_dst->getLabel();
+
+				ImGui::Text("Max flow");
+				ImGui::Separator();
+
+				ImGui::Text("%.*s -> %.*s", src.length(), src.data(), dst.length(), dst.data());
+				ImGui::Text("Value: %lld", static_cast<long long>(m_flow->value));
+				ImGui::Text("Cut edges: %zu", m_flow->cut_edges.size());
 
-			auto text = m_path.getString();
-			ImGui::Text("%.*s", text.length(), text.data());
-			if (m_path)
+				ImGui::Separator();
+				ImGui::Text("Initialisation: %.2f ms", m_flow->init_time);
+				ImGui::Text("Discharge: %.2f ms (%zu pushes, %zu relabels)", m_flow->discharge_time, m_flow->pushes, m_flow->relabels);
+				ImGui::Text("Global relabel: %.2f ms (%zu times)", m_flow->global_relabel_time, m_flow->global_relabels);
+				ImGui::Text("Minimum cut: %.2f ms", m_flow->cut_time);
+			}
+
+			else if (m_tasks.isRunning("Maximum flow"))
+				ImGui::Text("Computing the maximum flow...");
+
+			else
 			{
-				ImGui::Text("Lengh: %zu", m_path.getLength());
-				ImGui::Text("Weight: %d", m_path.getWeight());
+				ImGui::Text("Path");
+				ImGui::Separator();
+
+				// Searching again with another strategy adds a row to the history
+				int strategy = static_cast<int>(m_path_strategy);
+				ImGui::SetNextItemWidth(config::path_strategy_combo_width);
+				if (ImGui::Combo("Strategy", &strategy, path_strategy_names, IM_ARRAYSIZE(path_strategy_names)))
+				{
+					m_path_strategy = static_cast<PathStrategy>(strategy);
+					if (m_path_src && m_path_dst)
+						findPath();
+				}
+
+				auto text = m_path.getString();
+				if (m_tasks.isRunning("Path search"))
+					ImGui::Text("Searching...");
+
+				else
+					ImGui::Text("%.*s", text.length(), text.data());
+
+				if (m_path)
+				{
+					ImGui::Text("Lengh: %zu", m_path.getLength());
+					ImGui::Text("Weight: %d", m_path.getWeight());
+				}
+
+				if (m_path || m_path.unreachable())
+				{
+					const auto& stats = m_path.getStats();
+
+					ImGui::Separator();
+					ImGui::Text("Time: %.3f ms", stats.time);
+					ImGui::Text("Settled: %zu nodes, relaxed: %zu arcs", stats.settled, stats.relaxed);
+					ImGui::Text("Pushes: %zu, pops: %zu, peak frontier: %zu", stats.pushes, stats.pops, stats.peak_frontier);
+				}
+
+				if (!m_path_history.empty())
+				{
+					ImGui::SeparatorText("Recent searches");
+
+					static const char* columns[] = {
+						"Nodes",
+						"Strategy",
+						"Length",
+						"Weight",
+						"Time, ms",
+						"Settled",
+						"Relaxed",
+						"Pushes",
+						"Pops",
+						"Peak"
+					};
+
+					if (ImGui::BeginTable("table_path_history", std::size(columns), ImGuiTableFlags_Borders))
+					{
+						for (const char* column: columns)
+							ImGui::TableSetupColumn(column);
+
+						ImGui::TableHeadersRow();
+
+						for (const auto& query: m_path_history)
+						{
+							ImGui::TableNextRow();
+
+							ImGui::TableNextColumn();
+							ImGui::Text("%s -> %s", query.src.c_str(), query.dst.c_str());
+
+							ImGui::TableNextColumn();
+							ImGui::TextUnformatted(path_strategy_names[static_cast<int>(query.strategy)]);
+
+							ImGui::TableNextColumn();
+							if (query.reachable)
+								ImGui::Text("%zu", query.length);
+
+							else
+								ImGui::TextDisabled("unreachable");
+
+							ImGui::TableNextColumn();
+							if (query.reachable)
+								ImGui::Text("%d", query.weight);
+
+							ImGui::TableNextColumn();
+							ImGui::Text("%.3f", query.stats.time);
+
+							ImGui::TableNextColumn();
+							ImGui::Text("%zu", query.stats.settled);
+
+							ImGui::TableNextColumn();
+							ImGui::Text("%zu", query.stats.relaxed);
+
+							ImGui::TableNextColumn();
+							ImGui::Text("%zu", query.stats.pushes);
+
+							ImGui::TableNextColumn();
+							ImGui::Text("%zu", query.stats.pops);
+
+							ImGui::TableNextColumn();
+							ImGui::Text("%zu", query.stats.peak_frontier);
+						}
+
+						ImGui::EndTable();
+					}
+
+					if (ImGui::SmallButton("Clear history"))
+						m_path_history.clear();
+				}
 			}
 		}
 
@@ -213,41 +879,166 @@ void ObjectManager::processInterface()
 
 void ObjectManager::cleanup()
 {
+	// Snapshots built from now on no longer contain the deleted objects
+	if (!m_deleted_objects.empty() || m_clear)
+	{
+		bool edges_only = !m_clear && std::ranges::all_of(
+			m_deleted_objects,
+			[](container::iterator iter)
+			{
+				return dynamic_cast<Edge*>(*iter) != nullptr;
+			}
+		);
+
+		onGraphChanged(edges_only ? GraphChange::Edges : GraphChange::Nodes);
+	}
+
 	for (auto iter: m_deleted_objects)
 	{
-		delete *iter;
+		onObjectRemoved(*iter);
+		retire(*iter);
 		m_objects.erase(iter);
 	}
 
 	if (m_clear)
 	{
+		m_tasks.cancelAll();
+		m_tiles_stale = true;
+
 		for (auto object: m_objects)
-			delete object;
+			retire(object);
 
 		m_path = Path::Empty();
 		m_pathfind_overlay_show = false;
 		m_path_src = nullptr;
 		m_path_dst = nullptr;
 
+		resetPathPreview();
+		m_path_tree.reset();
+		m_path_tree_graph.reset();
+		m_hovered_node = nullptr;
+
+		m_flow.reset();
+		m_cut_edges.clear();
+
+		m_animations.clear();
 		m_objects.clear();
 		m_clear = false;
 	}
 
+	if (m_pending_import)
+	{
+		import(*m_pending_import);
+		m_pending_import.reset();
+	}
+
 	m_deleted_objects.clear();
+	reclaim();
+}
+
+void ObjectManager::retire(Object* object)
+{
+	m_retired.push_back({ object, m_graph_version });
+}
+
+void ObjectManager::onObjectChanging(Object* object)
+{
+	if (!m_tiles_active || m_tiles_stale)
+		return;
+
+	// Later changes before the next frame leave the tiles as they are
+	if (!m_changed_objects.insert(object).second)
+		return;
+
+	if (m_changed_objects.size() > config::tile_cache_max_changes)
+	{
+		m_tiles_stale = true;
+		m_changed_objects.clear();
+
+		return;
+	}
+
+	m_tile_cache.invalidate(object->getBounds());
+}
+
+void ObjectManager::onObjectRemoved(Object* object)
+{
+	if (!m_tiles_active || m_tiles_stale)
+		return;
+
+	m_changed_objects.erase(object);
+	m_tile_cache.remove(object);
+}
+
+void ObjectManager::reclaim()
+{
+	std::erase_if(
+		m_snapshots,
+		[](const auto& snapshot)
+		{
+			return snapshot.second.expired();
+		}
+	);
+
+	// The last snapshot is the manager's own. Unless a task holds it as well, it
+	// does not keep the removed objects alive: it is only read again to build
+	// the next snapshot, which never touches the objects removed since
+	size_t held = m_snapshots.size();
+	if (held && m_graph.use_count() == 1)
+		held--;
+
+	// Snapshots are built in the order of the versions, the first one alive is the oldest
+	size_t oldest = held
+		? m_snapshots.front().first
+		: m_graph_version;
+
+	while (!m_retired.empty() && m_retired.front().epoch <= oldest)
+	{
+		delete m_retired.front().object;
+		m_retired.pop_front();
+	}
 }
 
 //========================================
 
 void ObjectManager::onNodeDeleted(Node* node)
 {
-	if (m_path.contains(node))
+	if (m_path.contains(node) || node == m_path_src || node == m_path_dst)
 		cancelPathSearch();
+
+	if (m_path_preview.contains(node))
+		resetPathPreview();
+
+	if (node == m_hovered_node)
+		m_hovered_node = nullptr;
+
+	std::erase_if(
+		m_animations,
+		[node](const NodeAnimation& animation)
+		{
+			return animation.node == node;
+		}
+	);
 }
 
 void ObjectManager::onEdgeDeleted(Edge* edge)
 {
 	if (m_path.contains(edge))
 		cancelPathSearch();
+
+	if (m_path_preview.contains(edge))
+		resetPathPreview();
+
+	std::erase(m_cut_edges, edge);
+}
+
+void ObjectManager::onNodeHovered(Node* node, bool hovered)
+{
+	if (hovered)
+		m_hovered_node = node;
+
+	else if (node == m_hovered_node)
+		m_hovered_node = nullptr;
 }
 
 //========================================
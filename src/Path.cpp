@@ -5,11 +5,14 @@
 
 #include <Graph/Path.hpp>
 #include <Graph/Objects/Edge.hpp>
+#include <Graph/Algorithms/ShortestPath.hpp>
 
 //========================================
 
 Path::Path(Path&& path) noexcept:
-	m_path(std::move(path.m_path))
+	m_path(std::move(path.m_path)),
+	m_unreachable(path.m_unreachable),
+	m_stats(path.m_stats)
 {
 	update();
 }
@@ -19,6 +22,8 @@ Path& Path::operator=(Path&& path) noexcept
 	setIndication(false);
 
 	m_path = std::move(path.m_path);
+	m_unreachable = path.m_unreachable;
+	m_stats = path.m_stats;
 	setIndication(true);
 	update();
 
@@ -47,6 +52,11 @@ std::string_view Path::getString() const
 	return m_string;
 }
 
+const SearchStats& Path::getStats() const
+{
+	return m_stats;
+}
+
 Node* Path::getFirstNode() const
 {
 	return m_path.front().first;
@@ -77,11 +87,28 @@ bool Path::contains(Edge* edge) const
 	) != m_path.end();	
 }
 
+void Path::clear(const Path& keep)
+{
+	for (auto [node, edge]: m_path)
+		if (edge && !keep.contains(edge))
+			edge->setPathIndication(false);
+
+	m_path.clear();
+	m_unreachable = false;
+	m_stats = {};
+	update();
+}
+
 bool Path::empty() const
 {
 	return m_path.empty();
 }
 
+bool Path::unreachable() const
+{
+	return m_unreachable;
+}
+
 Path::operator bool() const
 {
 	return !empty();
@@ -94,66 +121,38 @@ Path Path::Empty()
 	return Path();
 }
 
-Path Path::Shortest(Node* src, Node* dst)
+Path Path::Unreachable()
 {
-	struct PassedNode
-	{
-		Node* node;
-		size_t offset;
-	};
+	Path path;
+	path.m_unreachable = true;
+	path.update();
 
-	std::vector<PassedNode> current_path, shortest_path;
-	current_path.emplace_back(src, 0);
+	return path;
+}
 
-	while (!current_path.empty())
+Path Path::FromCompact(const ObjectGraph& graph, const CompactPath& path)
+{
+	// Edge directions can make dst unreachable even within its component
+	if (path.nodes.empty())
 	{
-		auto& head = current_path.back();
-		if (head.node == dst && (!shortest_path.size() || current_path.size() < shortest_path.size()))
-			shortest_path = current_path;
-
-		const auto& edges = head.node->getConnectedEdges();
-		bool next_found = false;
+		auto result = Unreachable();
+		result.m_stats = path.stats;
 
-		while (!next_found && head.offset < edges.size())
-		{
-			if (shortest_path.size() != 0 && current_path.size() >= shortest_path.size())
-			{
-				head.offset++;
-				break;
-			}
-
-			Node* next = edges[head.offset++]->opposite(head.node);
-
-			if (
-				std::find_if(
-					current_path.begin(),
-					current_path.end(),
-					[next](const PassedNode& passed_node) -> bool
-					{
-						return passed_node.node == next;
-					}
-				) == current_path.end()
-			)
-			{
-				current_path.emplace_back(next, 0);
-				next_found = true;
-			}
-		}
-
-		if (!next_found)
-			current_path.pop_back();
+		return result;
 	}
 
 	Path result;
-	for (size_t i = 0; i < shortest_path.size(); i++)
+	result.m_stats = path.stats;
+
+	for (size_t i = 0; i < path.nodes.size(); i++)
 		result.m_path.emplace_back(
-			shortest_path[i].node,
-			i < shortest_path.size() - 1
-				? shortest_path[i].node->getConnectedEdges()[shortest_path[i].offset - 1]
+			graph.getNodeObject(path.nodes[i]),
+			i < path.edges.size()
+				? graph.getEdgeObject(path.edges[i])
 				: nullptr
 		);
 
-	return result;	
+	return result;
 }
 
 //========================================
@@ -192,7 +191,10 @@ void Path::update()
 
 	if (m_path.empty())
 	{
-		m_string = "Empty path";
+		m_string = m_unreachable
+			? "Unreachable"
+			: "Empty path";
+
 		return;
 	}
 
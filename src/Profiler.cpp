@@ -0,0 +1,369 @@
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <string_view>
+
+#include <Graph/Profiler.hpp>
+#include <Graph/ImGuiExtra.hpp>
+#include <Graph/Config.hpp>
+#include <Graph/Utils.hpp>
+
+//========================================
+
+namespace
+{
+
+float Milliseconds(std::chrono::steady_clock::duration duration)
+{
+	return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+// Every zone name keeps its colour between frames
+ImU32 ZoneColor(const char* name)
+{
+	auto hash = std::hash<std::string_view>()(name);
+	auto color = HSV(static_cast<int>(hash % 255), 0x90, 0xD0);
+
+	return IM_COL32(color.r, color.g, color.b, color.a);
+}
+
+} // namespace
+
+//========================================
+
+Profiler::Profiler():
+	m_frames(config::profiler_history),
+	m_trace_path(config::profiler_trace_filename)
+{}
+
+//========================================
+
+void Profiler::beginFrame()
+{
+	m_current.start = clock::now();
+	m_current.zones.clear();
+	m_open.clear();
+}
+
+void Profiler::endFrame()
+{
+	while (!m_open.empty())
+		end();
+
+	auto now = clock::now();
+	m_current.duration = Milliseconds(now - m_current.start);
+
+	if (m_tracing)
+		m_trace.push_back({
+			"Frame",
+			std::chrono::duration<double, std::micro>(m_current.start - m_trace_start).count(),
+			std::chrono::duration<double, std::micro>(now - m_current.start).count()
+		});
+
+	if (m_tracing && m_trace.size() >= config::profiler_trace_max_events)
+	{
+		stopTrace();
+		m_trace_message = std::format("Trace stopped at {} events", m_trace.size());
+	}
+
+	if (m_paused)
+		return;
+
+	// The zone vectors are swapped around the ring, so they stop allocating after a while
+	std::swap(m_frames[m_next], m_current);
+	m_next = (m_next + 1) % m_frames.size();
+	m_frame_count = std::min(m_frame_count + 1, m_frames.size());
+}
+
+void Profiler::begin(const char* name)
+{
+	m_open.push_back(m_current.zones.size());
+	m_current.zones.push_back({
+		name,
+		static_cast<unsigned>(m_open.size() - 1),
+		Milliseconds(clock::now() - m_current.start),
+		0
+	});
+}
+
+void Profiler::end()
+{
+	if (m_open.empty())
+		return;
+
+	auto& zone = m_current.zones[m_open.back()];
+	m_open.pop_back();
+
+	zone.duration = Milliseconds(clock::now() - m_current.start) - zone.start;
+
+	if (m_tracing)
+		m_trace.push_back({
+			zone.name,
+			std::chrono::duration<double, std::micro>(m_current.start - m_trace_start).count() + 1000. * zone.start,
+			1000. * zone.duration
+		});
+}
+
+//========================================
+
+void Profiler::startTrace()
+{
+	m_trace.clear();
+	m_trace_start = clock::now();
+	m_tracing = true;
+}
+
+void Profiler::stopTrace()
+{
+	m_tracing = false;
+}
+
+bool Profiler::isTracing() const
+{
+	return m_tracing;
+}
+
+bool Profiler::saveTrace(const std::filesystem::path& path) const
+{
+	std::ofstream stream(path);
+	if (!stream)
+		return false;
+
+	// Complete events of a single thread, nested by their time ranges
+	stream << "{\"traceEvents\":[\n";
+	for (size_t i = 0; i < m_trace.size(); i++)
+	{
+		const auto& event = m_trace[i];
+		stream << std::format(
+			"{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":{:.3f},\"dur\":{:.3f}}}{}\n",
+			event.name,
+			event.start,
+			event.duration,
+			i + 1 < m_trace.size() ? "," : ""
+		);
+	}
+
+	stream << "],\"displayTimeUnit\":\"ms\"}\n";
+	return static_cast<bool>(stream);
+}
+
+//========================================
+
+const Profiler::Frame& Profiler::getFrame(size_t age) const
+{
+	return m_frames[(m_next + m_frames.size() - 1 - age) % m_frames.size()];
+}
+
+void Profiler::showWindow(bool* open)
+{
+	if (ImGui::Begin("Profiler", open))
+	{
+		if (!m_frame_count)
+			ImGui::Text("No frames recorded");
+
+		else
+		{
+			ImGui::Checkbox("Pause", &m_paused);
+			if (!m_paused)
+				m_selected = 0;
+
+			// Frame times from the oldest to the latest
+			ImGui::PlotHistogram(
+				"##frame_times",
+				[](void* data, int index) -> float
+				{
+					auto* profiler = static_cast<Profiler*>(data);
+					return profiler->getFrame(profiler->m_frame_count - 1 - index).duration;
+				},
+				this,
+				static_cast<int>(m_frame_count),
+				0,
+				"Frame time",
+				0,
+				2 * config::profiler_frame_budget,
+				ImVec2(-1, config::profiler_plot_height)
+			);
+
+			// Older frames can be inspected while the recording is paused
+			ImGui::BeginDisabled(!m_paused);
+			ImGui::SliderInt("Frames ago", &m_selected, 0, static_cast<int>(m_frame_count) - 1);
+			ImGui::EndDisabled();
+
+			m_selected = std::clamp(m_selected, 0, static_cast<int>(m_frame_count) - 1);
+
+			const auto& frame = getFrame(m_selected);
+			ImGui::Text("Frame: %.2f ms (%.0f fps)", frame.duration, frame.duration > 0 ? 1000 / frame.duration : 0);
+
+			showFlameChart(frame);
+
+			ImGui::SeparatorText("Average over the recorded frames");
+			showSummary();
+		}
+
+		ImGui::SeparatorText("Chrome trace");
+
+		if (m_tracing)
+		{
+			if (ImGui::Button("Stop recording"))
+				stopTrace();
+		}
+
+		else if (ImGui::Button("Start recording"))
+		{
+			startTrace();
+			m_trace_message.clear();
+		}
+
+		ImGui::SameLine();
+		ImGui::Text("%zu events", m_trace.size());
+
+		ImGui::InputText("Path", &m_trace_path);
+
+		ImGui::BeginDisabled(m_trace.empty());
+		if (ImGui::Button("Save trace"))
+			m_trace_message = saveTrace(m_trace_path)
+				? std::format("Saved {} events", m_trace.size())
+				: std::format("Failed to write '{}'", m_trace_path);
+
+		ImGui::EndDisabled();
+
+		if (!m_trace_message.empty())
+			ImGui::TextUnformatted(m_trace_message.c_str());
+	}
+
+	ImGui::End();
+}
+
+void Profiler::showFlameChart(const Frame& frame)
+{
+	unsigned depth = 0;
+	for (const auto& zone: frame.zones)
+		depth = std::max(depth, zone.depth + 1);
+
+	const float row_height = config::profiler_flame_row_height;
+
+	auto origin = ImGui::GetCursorScreenPos();
+	float width = std::max(ImGui::GetContentRegionAvail().x, 1.f);
+
+	ImGui::InvisibleButton("##flame_chart", ImVec2(width, std::max(depth, 1u) * row_height));
+	bool hovered = ImGui::IsItemHovered();
+	auto mouse = ImGui::GetIO().MousePos;
+
+	// Frames within the budget are drawn to the same scale, longer ones are
+	// squeezed and the budget is marked
+	float scale = width / std::max(frame.duration, config::profiler_frame_budget);
+
+	auto* draw_list = ImGui::GetWindowDrawList();
+	for (const auto& zone: frame.zones)
+	{
+		ImVec2 min(origin.x + zone.start * scale, origin.y + zone.depth * row_height);
+		ImVec2 max(std::max(min.x + 1, min.x + zone.duration * scale), min.y + row_height - 1);
+
+		draw_list->AddRectFilled(min, max, ZoneColor(zone.name));
+
+		// Labels only where they fit
+		auto text_size = ImGui::CalcTextSize(zone.name);
+		if (text_size.x + 4 < max.x - min.x)
+			draw_list->AddText(
+				ImVec2(min.x + 2, min.y + .5f * (row_height - text_size.y)),
+				IM_COL32(0, 0, 0, 255),
+				zone.name
+			);
+
+		if (hovered && min.x <= mouse.x && mouse.x < max.x && min.y <= mouse.y && mouse.y < max.y)
+			ImGui::SetTooltip("%s\n%.3f ms", zone.name, zone.duration);
+	}
+
+	if (frame.duration > config::profiler_frame_budget)
+	{
+		float x = origin.x + config::profiler_frame_budget * scale;
+		draw_list->AddLine(
+			ImVec2(x, origin.y),
+			ImVec2(x, origin.y + depth * row_height),
+			IM_COL32(255, 45, 92, 255),
+			2
+		);
+	}
+}
+
+void Profiler::showSummary()
+{
+	struct Row
+	{
+		const char* name;
+		unsigned depth;
+		float total;
+		float max;
+	};
+
+	// Zones are told apart by name and depth, in the order of their first appearance
+	std::vector<Row> rows;
+	for (size_t age = m_frame_count; age-- > 0;)
+	{
+		for (const auto& zone: getFrame(age).zones)
+		{
+			auto iter = std::find_if(
+				rows.begin(),
+				rows.end(),
+				[&](const Row& row)
+				{
+					return row.depth == zone.depth && std::string_view(row.name) == zone.name;
+				}
+			);
+
+			if (iter == rows.end())
+				iter = rows.insert(rows.end(), { zone.name, zone.depth, 0, 0 });
+
+			iter->total += zone.duration;
+			iter->max = std::max(iter->max, zone.duration);
+		}
+	}
+
+	if (
+		ImGui::BeginTable(
+			"table_profiler",
+			3,
+			ImGuiTableFlags_Borders   |
+			ImGuiTableFlags_Resizable
+		)
+	)
+	{
+		ImGui::TableSetupColumn("Zone");
+		ImGui::TableSetupColumn("Mean, ms");
+		ImGui::TableSetupColumn("Max, ms");
+		ImGui::TableHeadersRow();
+
+		for (const auto& row: rows)
+		{
+			ImGui::TableNextRow();
+
+			ImGui::TableNextColumn();
+			ImGui::Text("%*s%s", static_cast<int>(2 * row.depth), "", row.name);
+
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", row.total / m_frame_count);
+
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", row.max);
+		}
+
+		ImGui::EndTable();
+	}
+}
+
+//========================================
+
+ProfileScope::ProfileScope(Profiler* profiler, const char* name):
+	m_profiler(profiler)
+{
+	if (m_profiler)
+		m_profiler->begin(name);
+}
+
+ProfileScope::~ProfileScope()
+{
+	if (m_profiler)
+		m_profiler->end();
+}
+
+//========================================
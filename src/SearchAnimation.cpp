@@ -0,0 +1,295 @@
+#include <algorithm>
+
+#include <Graph/SearchAnimation.hpp>
+#include <Graph/ImGuiExtra.hpp>
+#include <Graph/Config.hpp>
+
+//========================================
+
+SearchAnimation::SearchAnimation(ObjectManager& manager):
+	m_object_manager(manager),
+	m_speed(config::animation_default_speed),
+	m_budget(config::animation_max_budget)
+{}
+
+//========================================
+
+void SearchAnimation::show()
+{
+	if (Node* src = m_object_manager.getPathSrc())
+		m_source = src->getLabel();
+
+	m_show = true;
+}
+
+bool SearchAnimation::running() const
+{
+	return static_cast<bool>(m_steps);
+}
+
+bool SearchAnimation::isPlaying() const
+{
+	return running() && !m_paused;
+}
+
+void SearchAnimation::start()
+{
+	stop();
+
+	auto graph = m_object_manager.getGraphSnapshot();
+
+	const auto& nodes = graph->getNodeObjects();
+	auto iter = std::find_if(
+		nodes.begin(),
+		nodes.end(),
+		[&](Node* node)
+		{
+			return node->getLabel() == m_source;
+		}
+	);
+
+	if (iter == nodes.end())
+	{
+		m_message = "No node with this label";
+		return;
+	}
+
+	auto src = static_cast<CompactGraph::index_t>(iter - nodes.begin());
+	switch (static_cast<Algorithm>(m_algorithm))
+	{
+		case Algorithm::BreadthFirst:
+			m_steps = BreadthFirstSteps(*graph, src);
+			break;
+
+		case Algorithm::DepthFirst:
+			m_steps = DepthFirstSteps(*graph, src);
+			break;
+
+		case Algorithm::Dijkstra:
+			m_steps = DijkstraSteps(*graph, src);
+			break;
+	}
+
+	m_graph = std::move(graph);
+	m_states.assign(m_graph->getNodeCount(), NodeState::Unseen);
+	m_tree_edges.assign(m_graph->getNodeCount(), SearchStep::no_edge);
+
+	m_message.clear();
+	m_due = 0;
+	m_step_count = 0;
+	m_frontier = 0;
+	m_settled = 0;
+	m_distance = 0;
+
+	for (auto* node: nodes)
+		node->setColor(config::node_default_color);
+}
+
+void SearchAnimation::stop()
+{
+	m_steps = {};
+}
+
+void SearchAnimation::restore()
+{
+	if (!m_graph)
+		return;
+
+	for (CompactGraph::index_t node = 0; node < m_states.size(); node++)
+	{
+		if (m_states[node] != NodeState::Unseen)
+			m_graph->getNodeObject(node)->setColor(config::node_default_color);
+
+		if (m_tree_edges[node] != SearchStep::no_edge)
+			m_graph->getEdgeObject(m_tree_edges[node])->setPathIndication(false);
+	}
+
+	m_states.clear();
+	m_tree_edges.clear();
+	m_graph.reset();
+}
+
+//========================================
+
+bool SearchAnimation::advance()
+{
+	if (!m_steps.next())
+	{
+		stop();
+		m_message = "Finished";
+
+		return false;
+	}
+
+	const auto& step = m_steps.get();
+	m_step_count++;
+	m_distance = step.distance;
+
+	auto& state = m_states[step.node];
+	Node* node = m_graph->getNodeObject(step.node);
+
+	if (step.kind == SearchStep::Kind::Settle)
+	{
+		m_frontier--;
+		m_settled++;
+
+		state = NodeState::Settled;
+		node->setColor(config::animation_visited_color);
+
+		return true;
+	}
+
+	if (state == NodeState::Unseen)
+		m_frontier++;
+
+	state = NodeState::Frontier;
+	node->setColor(config::animation_frontier_color);
+
+	// A node reached again by a shorter path moves to another branch of the tree
+	auto& tree_edge = m_tree_edges[step.node];
+	if (tree_edge != SearchStep::no_edge)
+		m_graph->getEdgeObject(tree_edge)->setPathIndication(false);
+
+	tree_edge = step.edge;
+	if (tree_edge != SearchStep::no_edge)
+		m_graph->getEdgeObject(tree_edge)->setPathIndication(true);
+
+	return true;
+}
+
+void SearchAnimation::update()
+{
+	float frame_time = m_frame_clock.restart().asMicroseconds() / 1000.f;
+	if (!running())
+		return;
+
+	// Edits would leave the colours on objects no longer in the graph
+	if (!m_object_manager.isCurrent(*m_graph))
+	{
+		stop();
+		restore();
+		m_message = "Stopped, the graph has changed";
+
+		return;
+	}
+
+	if (m_paused)
+	{
+		if (m_single_step)
+			advance();
+
+		m_single_step = false;
+		return;
+	}
+
+	// Halve the budget as soon as the frames get late, grow it back slowly
+	m_budget = frame_time > config::animation_target_frame_time
+		? std::max(.5f * m_budget, config::animation_min_budget)
+		: std::min(1.1f * m_budget, config::animation_max_budget);
+
+	m_due += m_speed * frame_time / 1000;
+
+	sf::Clock clock;
+	while (m_due >= 1)
+	{
+		if (!advance())
+			return;
+
+		m_due--;
+
+		// Steps that do not fit are dropped rather than owed, so the search
+		// slows down instead of catching up in a burst later
+		if (clock.getElapsedTime().asMicroseconds() > 1000 * m_budget)
+		{
+			m_due = 0;
+			break;
+		}
+	}
+}
+
+//========================================
+
+void SearchAnimation::processInterface()
+{
+	if (!m_show)
+		return;
+
+	if (ImGui::Begin("Search animation", &m_show))
+	{
+		static const char* algorithms[] = {
+			"Breadth-first",
+			"Depth-first",
+			"Dijkstra"
+		};
+
+		ImGui::BeginDisabled(running());
+		ImGui::Combo("Algorithm", &m_algorithm, algorithms, std::size(algorithms));
+		ImGui::InputText("Source", &m_source);
+		ImGui::EndDisabled();
+
+		if (!running())
+		{
+			if (ImGui::Button("Start"))
+			{
+				restore();
+				start();
+			}
+
+			ImGui::SameLine();
+
+			ImGui::BeginDisabled(!m_graph);
+			if (ImGui::Button("Clear"))
+			{
+				restore();
+				m_message.clear();
+			}
+
+			ImGui::EndDisabled();
+		}
+
+		else
+		{
+			if (ImGui::Button("Stop"))
+			{
+				stop();
+				m_message = "Stopped";
+			}
+
+			ImGui::SameLine();
+			ImGui::Checkbox("Pause", &m_paused);
+
+			ImGui::SameLine();
+			ImGui::BeginDisabled(!m_paused);
+
+			if (ImGui::Button("Step"))
+				m_single_step = true;
+
+			ImGui::EndDisabled();
+		}
+
+		ImGui::SliderFloat("Speed", &m_speed, 1, config::animation_max_speed, "%.0f steps/s", ImGuiSliderFlags_Logarithmic);
+
+		if (!m_message.empty())
+			ImGui::TextUnformatted(m_message.c_str());
+
+		if (m_graph)
+		{
+			ImGui::Separator();
+			ImGui::Text("Steps: %zu", m_step_count);
+			ImGui::Text("Frontier: %zu, settled: %zu", m_frontier, m_settled);
+			ImGui::Text(
+				static_cast<Algorithm>(m_algorithm) == Algorithm::DepthFirst
+					? "Order: %lld"
+					: "Distance: %lld",
+				static_cast<long long>(m_distance)
+			);
+
+			ImGui::Text("Budget: %.2f ms per frame", m_budget);
+			ImGui::SetItemTooltip("Shrinks while the frame rate is below the target");
+		}
+	}
+
+	ImGui::End();
+}
+
+//========================================
@@ -0,0 +1,167 @@
+#include <Graph/TaskPool.hpp>
+#include <Graph/Parallel.hpp>
+
+//========================================
+
+namespace
+{
+
+// Pool and queue of the worker running on this thread, if any
+thread_local TaskPool* t_pool  = nullptr;
+thread_local size_t    t_index = 0;
+
+} // namespace
+
+//========================================
+
+void TaskContext::cancel()
+{
+	m_cancelled.store(true, std::memory_order_relaxed);
+}
+
+bool TaskContext::isCancelled() const
+{
+	return m_cancelled.load(std::memory_order_relaxed);
+}
+
+void TaskContext::setProgress(double progress)
+{
+	m_progress.store(progress, std::memory_order_relaxed);
+}
+
+double TaskContext::getProgress() const
+{
+	return m_progress.load(std::memory_order_relaxed);
+}
+
+//========================================
+
+TaskPool::TaskPool(size_t threads)
+{
+	m_workers.resize(std::max<size_t>(threads, 1));
+	for (auto& worker: m_workers)
+		worker = std::make_unique<Worker>();
+
+	m_threads.reserve(m_workers.size());
+	for (size_t i = 0; i < m_workers.size(); i++)
+		m_threads.emplace_back([this, i] { run(i); });
+}
+
+TaskPool::~TaskPool()
+{
+	{
+		std::lock_guard lock(m_sleep_mutex);
+		m_stop = true;
+	}
+
+	m_wake.notify_all();
+	m_threads.clear();
+}
+
+TaskPool& TaskPool::Default()
+{
+	static TaskPool pool(ThreadCount());
+	return pool;
+}
+
+size_t TaskPool::getThreadCount() const
+{
+	return m_workers.size();
+}
+
+//========================================
+
+void TaskPool::submit(Task task)
+{
+	// Counted first, so that a worker taking it right away never sees fewer queued tasks than taken
+	{
+		std::lock_guard lock(m_sleep_mutex);
+		m_queued++;
+	}
+
+	// Tasks spawned by a task stay with its worker until someone steals them
+	if (t_pool == this)
+	{
+		std::lock_guard lock(m_workers[t_index]->mutex);
+		m_workers[t_index]->tasks.push_back(std::move(task));
+	}
+
+	else
+	{
+		std::lock_guard lock(m_shared_mutex);
+		m_shared_tasks.push_back(std::move(task));
+	}
+
+	m_wake.notify_one();
+}
+
+bool TaskPool::take(size_t index, Task& task)
+{
+	auto pop = [&](std::mutex& mutex, std::deque<Task>& tasks, bool newest)
+	{
+		std::lock_guard lock(mutex);
+		if (tasks.empty())
+			return false;
+
+		if (newest)
+		{
+			task = std::move(tasks.back());
+			tasks.pop_back();
+		}
+
+		else
+		{
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+
+		return true;
+	};
+
+	if (pop(m_workers[index]->mutex, m_workers[index]->tasks, true))
+		return true;
+
+	if (pop(m_shared_mutex, m_shared_tasks, false))
+		return true;
+
+	for (size_t i = 1; i < m_workers.size(); i++)
+	{
+		auto& victim = *m_workers[(index + i) % m_workers.size()];
+		if (pop(victim.mutex, victim.tasks, false))
+			return true;
+	}
+
+	return false;
+}
+
+void TaskPool::run(size_t index)
+{
+	t_pool  = this;
+	t_index = index;
+
+	Task task;
+	while (true)
+	{
+		{
+			std::unique_lock lock(m_sleep_mutex);
+			m_wake.wait(lock, [this] { return m_stop || m_queued; });
+
+			if (m_stop)
+				return;
+		}
+
+		// Another worker may have taken the task that woke this one
+		if (!take(index, task))
+			continue;
+
+		{
+			std::lock_guard lock(m_sleep_mutex);
+			m_queued--;
+		}
+
+		task();
+		task = nullptr;
+	}
+}
+
+//========================================
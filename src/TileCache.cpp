@@ -0,0 +1,402 @@
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+#include <Graph/TileCache.hpp>
+#include <Graph/Config.hpp>
+
+//========================================
+
+namespace
+{
+
+// Antialiasing reaches a little beyond the shapes, in pixels
+constexpr float tile_margin = 2;
+
+// Objects without an index cell
+constexpr size_t unplaced = -1;
+
+int FloorDiv(float value, float divisor)
+{
+	return static_cast<int>(std::floor(value / divisor));
+}
+
+uint64_t CellKey(int x, int y)
+{
+	return static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32 | static_cast<uint32_t>(y);
+}
+
+float CellSize(size_t level)
+{
+	return std::ldexp(static_cast<float>(config::tile_size), static_cast<int>(level));
+}
+
+} // namespace
+
+//========================================
+
+void TileCache::invalidate(const sf::FloatRect& area)
+{
+	for (auto& [key, tile]: m_tiles)
+		if (!tile.dirty && tile.bounds.intersects(area))
+			tile.dirty = true;
+}
+
+void TileCache::update(Object* object)
+{
+	if (m_indexed)
+		index(object);
+
+	invalidate(object->getBounds());
+}
+
+void TileCache::remove(Object* object)
+{
+	invalidate(object->getBounds());
+
+	if (auto iter = m_entries.find(object); iter != m_entries.end())
+	{
+		unindex(iter->second);
+		m_entries.erase(iter);
+	}
+}
+
+void TileCache::clear()
+{
+	m_tiles.clear();
+	m_spare_textures.clear();
+
+	for (auto& cells: m_cells)
+		cells.clear();
+
+	m_entries.clear();
+	m_sequence = 0;
+	m_indexed = false;
+}
+
+//========================================
+
+bool TileCache::draw(sf::RenderTarget& target, const std::multiset<Object*, ObjectPtrCmp>& objects)
+{
+	m_frame++;
+
+	const float size = config::tile_size;
+	const auto& view = target.getView();
+	auto target_size = sf::Vector2f(target.getSize());
+
+	float scale    = view.getSize().x / target_size.x;
+	float rotation = view.getRotation();
+
+	// Linear part of the mapping from the world to the pixels of the target.
+	// The grid of the tiles is laid out in those pixels, so it stays in place
+	// when the view is moved
+	const float* matrix = view.getTransform().getMatrix();
+	sf::Transform to_grid(
+		 .5f * target_size.x * matrix[0],  .5f * target_size.x * matrix[4], 0,
+		-.5f * target_size.y * matrix[1], -.5f * target_size.y * matrix[5], 0,
+		 0,                                0,                               1
+	);
+
+	auto from_grid = to_grid.getInverse();
+
+	auto center = to_grid.transformPoint(view.getCenter());
+	int x0 = FloorDiv(center.x - .5f * target_size.x, size);
+	int y0 = FloorDiv(center.y - .5f * target_size.y, size);
+	int x1 = FloorDiv(center.x + .5f * target_size.x, size);
+	int y1 = FloorDiv(center.y + .5f * target_size.y, size);
+	int columns = x1 - x0 + 1;
+
+	// Visible tiles, row by row
+	std::vector<Tile*> visible;
+	bool redraw = false;
+
+	for (int y = y0; y <= y1; y++)
+	{
+		for (int x = x0; x <= x1; x++)
+		{
+			Key key { scale, rotation, x, y };
+			auto& tile = m_tiles[key];
+
+			if (!tile.texture)
+			{
+				tile.texture = createTexture();
+				if (!tile.texture)
+				{
+					m_tiles.erase(key);
+					return false;
+				}
+
+				sf::FloatRect cell(x * size, y * size, size, size);
+
+				sf::FloatRect margin = cell;
+				margin.left   -= tile_margin;
+				margin.top    -= tile_margin;
+				margin.width  += 2 * tile_margin;
+				margin.height += 2 * tile_margin;
+
+				tile.bounds = from_grid.transformRect(margin);
+
+				// The same scale and rotation as the target, centred on the cell
+				tile.view.setCenter(from_grid.transformPoint(cell.left + .5f * size, cell.top + .5f * size));
+				tile.view.setSize(
+					size * view.getSize().x / target_size.x,
+					size * view.getSize().y / target_size.y
+				);
+				tile.view.setRotation(rotation);
+
+				tile.dirty = true;
+			}
+
+			tile.last_used = m_frame;
+			visible.push_back(&tile);
+
+			redraw |= tile.dirty;
+		}
+	}
+
+	if (redraw)
+	{
+		if (!m_indexed)
+		{
+			for (auto* object: objects)
+				index(object);
+
+			m_indexed = true;
+		}
+
+		std::vector<sf::FloatRect> areas;
+		for (auto* tile: visible)
+			if (tile->dirty)
+				areas.push_back(tile->bounds);
+
+		// Every object around the dirty tiles goes to the ones it overlaps, in the order they are drawn in
+		std::vector<std::vector<Object*>> contents(visible.size());
+		for (auto* object: query(areas))
+		{
+			auto bounds = object->getBounds();
+			if (bounds.width <= 0 && bounds.height <= 0)
+				continue;
+
+			auto area = to_grid.transformRect(bounds);
+
+			int left   = std::max(x0, FloorDiv(area.left - tile_margin, size));
+			int top    = std::max(y0, FloorDiv(area.top  - tile_margin, size));
+			int right  = std::min(x1, FloorDiv(area.left + area.width  + tile_margin, size));
+			int bottom = std::min(y1, FloorDiv(area.top  + area.height + tile_margin, size));
+
+			for (int y = top; y <= bottom; y++)
+			{
+				for (int x = left; x <= right; x++)
+				{
+					size_t index = (y - y0) * columns + (x - x0);
+					if (visible[index]->dirty)
+						contents[index].push_back(object);
+				}
+			}
+		}
+
+		for (size_t i = 0; i < visible.size(); i++)
+		{
+			auto& tile = *visible[i];
+			if (!tile.dirty)
+				continue;
+
+			tile.texture->setView(tile.view);
+			tile.texture->clear(sf::Color::Transparent);
+
+			for (auto* object: contents[i])
+				object->draw(*tile.texture);
+
+			tile.texture->display();
+			tile.dirty = false;
+		}
+	}
+
+	// Drawn onto a transparent texture, the colours of the tiles are already
+	// multiplied by their alpha
+	sf::RenderStates states(sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha));
+	for (size_t i = 0; i < visible.size(); i++)
+	{
+		int x = x0 + static_cast<int>(i) % columns;
+		int y = y0 + static_cast<int>(i) / columns;
+
+		states.transform = from_grid;
+		states.transform.translate(x * size, y * size);
+
+		target.draw(sf::Sprite(visible[i]->texture->getTexture()), states);
+	}
+
+	evict();
+	return true;
+}
+
+//========================================
+
+std::unique_ptr<sf::RenderTexture> TileCache::createTexture()
+{
+	if (!m_spare_textures.empty())
+	{
+		auto texture = std::move(m_spare_textures.back());
+		m_spare_textures.pop_back();
+
+		return texture;
+	}
+
+	sf::ContextSettings settings;
+	settings.antialiasingLevel = config::tile_antialiasing_level;
+
+	auto texture = std::make_unique<sf::RenderTexture>();
+	if (!texture->create(config::tile_size, config::tile_size, settings))
+		return nullptr;
+
+	return texture;
+}
+
+void TileCache::index(Object* object)
+{
+	IndexEntry entry { unplaced, 0, 0, 0 };
+
+	if (auto iter = m_entries.find(object); iter != m_entries.end())
+	{
+		unindex(iter->second);
+		entry.sequence = iter->second.sequence;
+	}
+
+	else
+		entry.sequence = m_sequence++;
+
+	auto bounds = object->getBounds();
+	if (bounds.width > 0 || bounds.height > 0)
+	{
+		float extent = std::max(bounds.width, bounds.height);
+
+		entry.level = 0;
+		while (CellSize(entry.level) < extent && entry.level + 1 < index_levels)
+			entry.level++;
+
+		float size = CellSize(entry.level);
+		entry.cell = CellKey(
+			FloorDiv(bounds.left + .5f * bounds.width,  size),
+			FloorDiv(bounds.top  + .5f * bounds.height, size)
+		);
+
+		auto& items = m_cells[entry.level][entry.cell];
+		entry.slot = items.size();
+		items.push_back({ object, object->getPriority(), entry.sequence });
+	}
+
+	m_entries[object] = entry;
+}
+
+void TileCache::unindex(const IndexEntry& entry)
+{
+	if (entry.level == unplaced)
+		return;
+
+	auto cell = m_cells[entry.level].find(entry.cell);
+	auto& items = cell->second;
+
+	// The last object of the cell takes the place of the removed one
+	items[entry.slot] = items.back();
+	m_entries[items[entry.slot].object].slot = entry.slot;
+	items.pop_back();
+
+	if (items.empty())
+		m_cells[entry.level].erase(cell);
+}
+
+std::vector<Object*> TileCache::query(const std::vector<sf::FloatRect>& areas) const
+{
+	std::vector<IndexItem> found;
+
+	for (size_t level = 0; level < index_levels; level++)
+	{
+		const auto& cells = m_cells[level];
+		if (cells.empty())
+			continue;
+
+		float size = CellSize(level);
+		for (const auto& area: areas)
+		{
+			// Objects reach half a cell beyond their cell
+			int x0 = FloorDiv(area.left - .5f * size, size);
+			int y0 = FloorDiv(area.top  - .5f * size, size);
+			int x1 = FloorDiv(area.left + area.width  + .5f * size, size);
+			int y1 = FloorDiv(area.top  + area.height + .5f * size, size);
+
+			// Sparse levels are cheaper to walk than the cells of the area
+			uint64_t count = static_cast<uint64_t>(x1 - x0 + 1) * static_cast<uint64_t>(y1 - y0 + 1);
+			if (count > cells.size())
+			{
+				for (const auto& [key, items]: cells)
+				{
+					auto x = static_cast<int>(static_cast<uint32_t>(key >> 32));
+					auto y = static_cast<int>(static_cast<uint32_t>(key));
+
+					if (x >= x0 && x <= x1 && y >= y0 && y <= y1)
+						found.insert(found.end(), items.begin(), items.end());
+				}
+
+				continue;
+			}
+
+			for (int y = y0; y <= y1; y++)
+			{
+				for (int x = x0; x <= x1; x++)
+				{
+					if (auto cell = cells.find(CellKey(x, y)); cell != cells.end())
+						found.insert(found.end(), cell->second.begin(), cell->second.end());
+				}
+			}
+		}
+	}
+
+	std::sort(
+		found.begin(),
+		found.end(),
+		[](const IndexItem& a, const IndexItem& b)
+		{
+			return std::tie(a.priority, a.sequence) < std::tie(b.priority, b.sequence);
+		}
+	);
+
+	// Areas next to each other find the same objects
+	std::vector<Object*> objects;
+	objects.reserve(found.size());
+
+	for (size_t i = 0; i < found.size(); i++)
+		if (i == 0 || found[i].object != found[i - 1].object)
+			objects.push_back(found[i].object);
+
+	return objects;
+}
+
+void TileCache::evict()
+{
+	if (m_tiles.size() <= config::tile_cache_max_tiles)
+		return;
+
+	// Visible tiles stay, even when there are more of them than the limit
+	std::vector<std::map<Key, Tile>::iterator> unused;
+	for (auto iter = m_tiles.begin(); iter != m_tiles.end(); iter++)
+		if (iter->second.last_used != m_frame)
+			unused.push_back(iter);
+
+	std::sort(
+		unused.begin(),
+		unused.end(),
+		[](const auto& a, const auto& b)
+		{
+			return a->second.last_used < b->second.last_used;
+		}
+	);
+
+	size_t count = std::min(m_tiles.size() - config::tile_cache_max_tiles, unused.size());
+	for (size_t i = 0; i < count; i++)
+	{
+		m_spare_textures.push_back(std::move(unused[i]->second.texture));
+		m_tiles.erase(unused[i]);
+	}
+}
+
+//========================================
@@ -86,4 +86,14 @@ sf::Color HSV(int h, int s, int v, int a /*= 0xFF*/)
 	return rgb;
 }
 
+sf::FloatRect Union(const sf::FloatRect& a, const sf::FloatRect& b)
+{
+	float left   = std::min(a.left, b.left);
+	float top    = std::min(a.top,  b.top );
+	float right  = std::max(a.left + a.width,  b.left + b.width );
+	float bottom = std::max(a.top  + a.height, b.top  + b.height);
+
+	return sf::FloatRect(left, top, right - left, bottom - top);
+}
+
 //========================================
\ No newline at end of file